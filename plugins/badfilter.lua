@@ -93,3 +93,11 @@ function run(sz)
 	end
 end
 
+-- forget filter history, so instance can be reused after cleanup()
+function reset()
+	for i = 1, #tmp1 do
+		tmp1[i] = 0
+		tmp2[i] = 0
+	end
+	tmp1.pos, tmp2.pos = 0, 0
+end
@@ -0,0 +1,104 @@
+-- Example lowpass filter plugin for Lualadspa plugin developers.
+-- Shows how to use background worker and channel groups.
+-- You can share, use, copy, paste this file and edit it for your needs.
+--
+-- This AND ONLY THIS file is released UNLICENSED into PUBLIC DOMAIN,
+-- PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+-- OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+-- MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+-- See http://creativecommons.org/licenses/publicdomain for more info.
+
+info = {
+	name = "Biquad Lowpass Example",
+	label = "plugbiquad",
+	maker = "LuaLadspa Community",
+	copyright = "unlicensed",
+	realtime = true,
+	worker = true, -- start background worker for each instance
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+ports = {
+	{
+		type = "ia",
+		name = "Input Channel",
+		channels = 2
+	}, {
+		type = "oa",
+		name = "Output Channel",
+		channels = 2
+	}, {
+		type = "ic",
+		name = "Cutoff",
+		hint = "log freq",
+		min  = 20,
+		max  = 20000,
+		default = "middle"
+	}, {
+		type = "ic",
+		name = "Resonance",
+		min  = 0.5,
+		max  = 10,
+		default = "min"
+	}
+}
+
+-- this function is called in the WORKER state (main chunk is executed
+-- there too, so it's just a global)
+function coefficients(cutoff, q)
+	local rate = ladspa.getSampleRate()
+	cutoff = math.clamp(cutoff, 10, rate * 0.45)
+	q = math.max(q, 0.1)
+	local w = 2 * math.pi * cutoff / rate
+	local alpha = math.sin(w) / (2 * q)
+	local cs = math.cos(w)
+	local a0 = 1 + alpha
+	local b1 = (1 - cs) / a0
+	return {b1 / 2, b1, b1 / 2, -2 * cs / a0, (1 - alpha) / a0}
+end
+
+if ladspa.isWorker() then
+	return -- nothing else is needed there
+end
+
+local coef = {0, 0, 0, 0, 0} -- silence until first result
+local state = {{0, 0, 0, 0}, {0, 0, 0, 0}}
+local cutoff, q = -1, -1
+local pending = false
+
+-- results of ladspa.post() are delivered here, before run()
+function onWorkDone(job, c)
+	coef = c
+	pending = false
+end
+
+function onWorkError(job, message)
+	pending = false
+end
+
+function activate()
+	state = {{0, 0, 0, 0}, {0, 0, 0, 0}}
+end
+
+function run(sz)
+	local c, r = buffers[5][1], buffers[6][1]
+	-- recompute coefficients in background, when controls are changed
+	if not pending and (c ~= cutoff or r ~= q) then
+		pending = ladspa.post("coefficients", c, r)
+		if pending then cutoff, q = c, r end
+	end
+end
+
+function runChannel(sz, ch, input, out)
+	local b0, b1, b2, a1, a2 = coef[1], coef[2], coef[3], coef[4], coef[5]
+	local s = state[ch]
+	local x1, x2, y1, y2 = s[1], s[2], s[3], s[4]
+	for i = 1, sz do
+		local x = input[i]
+		local y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2
+		x2, x1, y2, y1 = x1, x, y1, y
+		out[i] = y
+	end
+	s[1], s[2], s[3], s[4] = x1, x2, y1, y2
+end
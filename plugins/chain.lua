@@ -0,0 +1,26 @@
+-- Example chain plugin for Lualadspa plugin developers.
+-- Runs two other example plugins in one instance, as one LADSPA plugin.
+-- You can share, use, copy, paste this file and edit it for your needs.
+--
+-- This AND ONLY THIS file is released UNLICENSED into PUBLIC DOMAIN,
+-- PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+-- OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+-- MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+-- See http://creativecommons.org/licenses/publicdomain for more info.
+
+info = {
+	name = "Filter + Compressor Chain Example",
+	label = "plugchain",
+	maker = "LuaLadspa Community",
+	copyright = "unlicensed",
+	realtime = true,
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+-- files are relative to this one. Audio outputs of each stage go to
+-- audio inputs of the next one, control ports are named "<name>: <port>"
+chain = {
+	{file = "badfilter.lua", name = "Filter"},
+	{file = "compressor.lua", name = "Compressor"}
+}
@@ -0,0 +1,103 @@
+-- Simple stereo compressor example for Lualadspa plugin developers.
+--
+-- This AND ONLY THIS file is released UNLICENSED into PUBLIC DOMAIN,
+-- PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+-- OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+-- MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+-- See http://creativecommons.org/licenses/publicdomain for more info.
+
+info = {
+	name = "Simple Compressor Example", 
+	label = "plugcompressor",
+	maker = "LuaLadspa Community",
+	copyright = "unlicensed",
+	realtime = true,
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+ports = {
+	{
+		type = "ia",
+		name = "Input Channel 1", 
+	}, { 
+		type = "ia",
+		name = "Input Channel 2",
+	}, {
+		type = "oa",
+		name = "Output Channel 1",
+	}, {
+		type = "oa",
+		name = "Output Channel 2",
+	}, {
+		type = "ic",
+		name = "Threshold (dB)",
+		min  = -60,
+		max  = 0,
+		default = "middle"
+	}, {
+		type = "ic",
+		name = "Ratio",
+		min  = 1,
+		max  = 20,
+		default = "low"
+	}, {
+		type = "ic",
+		name = "Attack (ms)",
+		min  = 0.1,
+		max  = 100,
+		default = "low"
+	}, {
+		type = "ic",
+		name = "Release (ms)",
+		min  = 10,
+		max  = 1000,
+		default = "low"
+	}
+}
+
+-- all heavy work is done by native objects, state is kept there too
+local env1 = ladspa.newEnvelope(10, 100)
+local env2 = ladspa.newEnvelope(10, 100)
+local comp = ladspa.newGainComputer(-30, 2, 6)
+local envbuf = ladspa.newBuffer(512)
+local gainbuf = ladspa.newBuffer(512)
+local bufsize = 512
+
+local function proc(out, input, env, sz)
+	env:process(input, envbuf, sz)
+	comp:process(envbuf, gainbuf, sz)
+	for i = 1, sz do
+		out[i] = input[i] * gainbuf[i]
+	end
+end
+
+function run(sz)
+	if sz > bufsize then
+		ladspa.resizeBuffer(envbuf, sz)
+		ladspa.resizeBuffer(gainbuf, sz)
+		bufsize = sz
+	end
+
+	-- hosts may give us values out of range
+	local attack = buffers[7][1]
+	local release = buffers[8][1]
+	env1:set(attack, release)
+	env2:set(attack, release)
+	comp:set(buffers[5][1], math.max(buffers[6][1], 1), 6)
+
+	proc(buffers[3], buffers[1], env1, sz)
+	proc(buffers[4], buffers[2], env2, sz)
+end
+
+function activate()
+	env1:reset()
+	env2:reset()
+end
+
+-- called after cleanup(), before instance is kept for reuse : plugin must
+-- look like it was just loaded. Without it instances are not reused.
+function reset()
+	env1:reset()
+	env2:reset()
+end
@@ -14,7 +14,10 @@ info = {
 	maker = "LuaLadspa Community",
 	copyright = "unlicensed",
 	realtime = true,
-	luaLadspaVersionMinor = 0,
+	-- clipping makes a lot of harmonics, run at 4x samplerate to keep
+	-- them from aliasing back (1, 2, 4 or 8)
+	oversample = 4,
+	luaLadspaVersionMinor = 3,
 	luaLadspaVersionMajor = 0
 }
 
@@ -40,6 +43,10 @@ ports = {
 	}, {
 		type = "ic",
 		name = "Cutoff",
+	}, {
+		-- lualadspa reports latency of oversampling filters here
+		type = "oc",
+		name = "latency",
 	}
 } 
 
@@ -0,0 +1,43 @@
+-- Example graph plugin for Lualadspa plugin developers.
+-- Runs filter and distorsion on the same input in parallel, and mixes
+-- their outputs back together, as one LADSPA plugin.
+-- You can share, use, copy, paste this file and edit it for your needs.
+--
+-- This AND ONLY THIS file is released UNLICENSED into PUBLIC DOMAIN,
+-- PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+-- OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+-- MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+-- See http://creativecommons.org/licenses/publicdomain for more info.
+
+info = {
+	name = "Parallel Filter + Distorsion Graph Example",
+	label = "pluggraph",
+	maker = "LuaLadspa Community",
+	copyright = "unlicensed",
+	realtime = true,
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+-- every node is a separate instance of plugin file (relative to this
+-- one). Nodes that don't depend on each other run in parallel.
+-- Endpoints are "node:port" (port index or name), "in:N" and "out:N".
+graph = {
+	inputs = 2,
+	outputs = 2,
+	nodes = {
+		{name = "Filter", file = "badfilter.lua"},
+		{name = "Dist", file = "distorsion.lua"},
+		{name = "Left", file = "mixer.lua"},
+		{name = "Right", file = "mixer.lua"}
+	},
+	connect = {
+		{"in:1", "Filter:1"}, {"in:2", "Filter:2"},
+		{"in:1", "Dist:1"}, {"in:2", "Dist:2"},
+		{"Filter:Output Channel 1", "Left:1"},
+		{"Dist:Output Channel 1", "Left:2"},
+		{"Filter:Output Channel 2", "Right:1"},
+		{"Dist:Output Channel 2", "Right:2"},
+		{"Left:Output", "out:1"}, {"Right:Output", "out:2"}
+	}
+}
@@ -136,15 +136,19 @@ ports = {
 -- Plugin implementation (can be above too :))
 --]]
 
+-- locals are faster than table lookups
+local load4, store4 = ladspa.load4, ladspa.store4
+
 function run(sz)
 	-- do NOT put this just in main chunk function!
 	-- (or do this at least in activate, by sharing this local globally)
 	local out = buffers[3]
 	local in1 = buffers[1]
 	local in2 = buffers[2]
-	-- mixing work
-	for i = 1, sz do
-		out[i] = (in1[i] + in2[i]) / 2
+	-- mixing work, 4 samples at once (luau vectors)
+	-- it's the same as out[i] = (in1[i] + in2[i]) / 2, but much faster
+	for i = 1, sz, 4 do
+		store4(out, i, (load4(in1, i) + load4(in2, i)) * 0.5)
 	end
 end
 
@@ -8,23 +8,19 @@ info = {
 	maker = "UtoECat",
 	copyright = "GNU GPL",
 	realtime = true,
-	luaLadspaVersionMinor = 1,
+	luaLadspaVersionMinor = 3,
 	luaLadspaVersionMajor = 0
 }
 
 ports = {
 	{
 		type = "ia",
-		name = "Input Channel 1", 
-	}, { 
-		type = "ia",
-		name = "Input Channel 2",
-	}, {
-		type = "oa",
-		name = "Output Channel 1",
+		name = "Input Channel", -- "Input Channel 1" and "Input Channel 2"
+		channels = 2
 	}, {
 		type = "oa",
-		name = "Output Channel 2",
+		name = "Output Channel",
+		channels = 2
 	}, {
 		type = "ic",
 		name = "Volume",
@@ -53,7 +49,16 @@ local amp_cache = {
 	0, 0
 }
 
-local function proc(out, input, sz, id)
+-- called once per block, before runChannel()
+function run(sz)
+	-- here is a way to get control values :D
+	-- (channel groups are expanded, so ports 1-4 are audio ones)
+	lim = buffers[5][1]
+	ak = buffers[6][1]
+end
+
+-- called for each channel with ports of this channel (in ports order)
+function runChannel(sz, id, input, out)
 	local maxv = 0
 	local amp = amp_cache[id]
 
@@ -75,18 +80,14 @@ local function proc(out, input, sz, id)
 	amp_cache[id] = math.max(amp, 0.0001)
 end
 
-function run(sz)
-	local ou1 = buffers[3]
-	local ou2 = buffers[4]
-	local in1 = buffers[1]
-	local in2 = buffers[2]
-
-	-- here is a way to get control values :D
-	lim = buffers[5][1]
-	ak = buffers[6][1]
-
-	-- work
-	proc(ou1, in1, sz, 1)
-	proc(ou2, in2, sz, 2)
+-- amplifiers take a while to settle, so host may keep them in presets
+function saveState()
+	return amp_cache
 end
 
+function loadState(state)
+	if type(state) == "table" then
+		amp_cache[1] = tonumber(state[1]) or 0
+		amp_cache[2] = tonumber(state[2]) or 0
+	end
+end
@@ -0,0 +1,74 @@
+-- Simple convolution reverb example for Lualadspa plugin developers.
+--
+-- This AND ONLY THIS file is released UNLICENSED into PUBLIC DOMAIN,
+-- PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+-- OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+-- MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+-- See http://creativecommons.org/licenses/publicdomain for more info.
+
+info = {
+	name = "Simple Convolution Reverb Example", 
+	label = "plugreverb",
+	maker = "LuaLadspa Community",
+	copyright = "unlicensed",
+	realtime = true,
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+ports = {
+	{
+		type = "ia",
+		name = "Input",
+	}, {
+		type = "oa",
+		name = "Output",
+	}, {
+		type = "ic",
+		name = "Dry/Wet",
+		min  = 0,
+		max  = 1,
+		default = "middle"
+	}
+}
+
+-- impulse response : exponentially decaying noise, one second long.
+-- It's generated only once per plugin type and samplerate, since
+-- convolver is named.
+local function makeIR()
+	local len = ladspa.getSampleRate()
+	local ir = ladspa.newBuffer(len)
+	local seed = 1
+	for i = 1, len do
+		seed = (seed * 1103515245 + 12345) % 2147483648
+		ir[i] = (seed / 1073741824 - 1) * math.exp(-6 * i / len) * 0.05
+	end
+	return ir
+end
+
+local conv -- created in activate(), main chunk has no samplerate
+local wet = ladspa.newBuffer(512)
+local wetsize = 512
+
+function run(sz)
+	local input = buffers[1]
+	local output = buffers[2]
+	local mix = buffers[3][1]
+
+	if sz > wetsize then
+		ladspa.resizeBuffer(wet, sz)
+		wetsize = sz
+	end
+	conv:process(input, wet, sz)
+	for i = 1, sz do
+		output[i] = input[i] * (1 - mix) + wet[i] * mix
+	end
+end
+
+function activate()
+	if not conv then
+		local name = "room"..tostring(ladspa.getSampleRate())
+		conv = ladspa.newConvolver(makeIR, 512, name)
+	end
+	conv:reset()
+end
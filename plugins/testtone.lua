@@ -0,0 +1,67 @@
+-- Test tone generator example for Lualadspa plugin developers.
+--
+-- This AND ONLY THIS file is released UNLICENSED into PUBLIC DOMAIN,
+-- PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+-- OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+-- MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+-- See http://creativecommons.org/licenses/publicdomain for more info.
+
+info = {
+	name = "Test Tone Generator", 
+	label = "plugtesttone",
+	maker = "LuaLadspa Community",
+	copyright = "unlicensed",
+	realtime = true,
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+ports = {
+	{
+		type = "oa",
+		name = "Output",
+	}, {
+		type = "ic",
+		name = "Frequency (Hz)",
+		min  = 20,
+		max  = 20000,
+		hint = "log",
+		default = "low"
+	}, {
+		type = "ic",
+		name = "Shape (sine, saw, square, triangle)",
+		min  = 0,
+		max  = 3,
+		hint = "int",
+		default = "min"
+	}, {
+		type = "ic",
+		name = "Amplitude",
+		min  = 0,
+		max  = 1,
+		default = "middle"
+	}
+}
+
+local shapes = {"sine", "saw", "square", "triangle"}
+local osc = ladspa.newOscillator("sine")
+local current = 1
+
+function run(sz)
+	local out = buffers[1]
+	local shape = math.clamp(math.floor(buffers[3][1]), 0, 3) + 1
+	local amp = buffers[4][1]
+
+	if shape ~= current then
+		osc:setShape(shapes[shape])
+		current = shape
+	end
+	osc:render(out, sz, buffers[2][1])
+	for i = 1, sz do
+		out[i] = out[i] * amp
+	end
+end
+
+function activate()
+	osc:reset()
+end
@@ -0,0 +1,264 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Asynchronous block processing for non realtime plugins
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+
+/*
+ * Host thread only copies inputs into rings and finished outputs out of
+ * them. Plugin run() is called by the async thread with fixed block
+ * size B. Output of block k is placed exactly latency = 2B samples after
+ * it's input, so delay never changes : if the async thread is late, host
+ * gets silence for that block instead of shifted audio.
+ *
+ * Rings are indexed by absolute sample position (modulo ring size).
+ */
+constexpr size_t async_ring_blocks = 4; // ring size in blocks
+
+class AsyncRunner {
+	public:
+	PluginHandle* H;
+	size_t block;  // B
+	size_t ring;   // ring size
+	size_t delay;  // 2B
+
+	// per port rings for audio, values for control ports
+	std::vector<std::vector<sample_type>> rings;
+	std::unique_ptr<std::atomic<float>[]> controls;
+
+	// async thread block buffers
+	std::vector<std::vector<sample_type>> local;
+	std::unique_ptr<sample_type*[]> connected;
+
+	uint64_t hostPos = 0; // host thread only
+	std::atomic<uint64_t> inputEnd{0};  // input available up to
+	std::atomic<uint64_t> outputEnd{0}; // output written up to
+	std::atomic<size_t> xruns{0};
+	bool warned = false;
+
+	std::mutex lock; // for waiting only
+	std::condition_variable cv;
+	std::atomic<bool> stop{false};
+	std::thread thread;
+
+	void loop();
+	void silence(uint64_t from, uint64_t to); // of output rings
+	void hostChunk(sample_type* const* host, size_t offset, size_t n);
+};
+
+void AsyncDeleter::operator()(AsyncRunner* A) const {
+	A->stop = true;
+	A->cv.notify_one();
+	if (A->thread.joinable()) A->thread.join();
+	delete A;
+}
+
+AsyncPtr NewAsyncRunner(PluginHandle* H) {
+	const PluginProperties* P = H->P.get();
+	AsyncPtr A(new AsyncRunner);
+	A->H = H;
+	A->block = P->async;
+	A->ring = A->block * async_ring_blocks;
+	A->delay = A->block * 2;
+	A->rings.resize(P->portCount);
+	A->local.resize(P->portCount);
+	A->controls = std::make_unique<std::atomic<float>[]>(P->portCount);
+	A->connected = std::make_unique<sample_type*[]>(P->portCount);
+	for (size_t i = 0; i < P->portCount; i++) {
+		const auto desc = P->portDescriptors[i];
+		A->controls[i] = 0.0f;
+		if (IS_AUDIO(desc)) {
+			A->rings[i].assign(A->ring, 0.0f);
+			A->local[i].assign(A->block, 0.0f);
+		} else A->local[i].assign(1, 0.0f);
+		A->connected[i] = A->local[i].data();
+	}
+	return A;
+}
+
+size_t AsyncLatency(const PluginHandle* H) {
+	return H->async->delay;
+}
+
+void StartAsync(PluginHandle* H) {
+	AsyncRunner* A = H->async.get();
+	StopAsync(H);
+	for (auto& r : A->rings) std::fill(r.begin(), r.end(), 0.0f);
+	A->hostPos = 0;
+	A->inputEnd = 0;
+	A->outputEnd = A->delay; // silence before the first block
+	A->stop = false;
+	A->thread = std::thread(&AsyncRunner::loop, A);
+}
+
+void StopAsync(PluginHandle* H) {
+	AsyncRunner* A = H->async.get();
+	if (!A->thread.joinable()) return;
+	A->stop = true;
+	A->cv.notify_one();
+	A->thread.join();
+	if (A->xruns) logError("Async plugin %s was late %i times!",
+		H->P->name, (int)A->xruns.exchange(0));
+}
+
+void AsyncRunner::loop() {
+	const PluginProperties* P = H->P.get();
+	uint64_t start = 0; // of the next block
+	while (!stop && !H->shutdown) {
+		uint64_t avail = inputEnd.load(std::memory_order_acquire);
+		if (start + block > avail) {
+			std::unique_lock<std::mutex> guard(lock);
+			cv.wait_for(guard, std::chrono::milliseconds(10), [&] () {
+				return stop || inputEnd.load(std::memory_order_acquire) >= start + block;
+			});
+			continue;
+		}
+		// too late, host will overwrite this input soon. Skip to the newest
+		if (avail - start > ring - block) {
+			const uint64_t next = (avail / block - 1) * block;
+			silence(start + delay, next + delay);
+			start = next;
+			xruns++;
+		}
+
+		// take input
+		for (size_t i = 0; i < P->portCount; i++) {
+			const auto desc = P->portDescriptors[i];
+			if (!IS_INPUT(desc)) continue;
+			if (IS_CONTROL(desc)) {
+				local[i][0] = controls[i].load(std::memory_order_relaxed);
+				continue;
+			}
+			const size_t off = start % ring; // ring is multiple of block
+			std::memcpy(local[i].data(), rings[i].data() + off,
+				block * sizeof(sample_type));
+		}
+
+		ProcessBlock(H, connected.get(), block);
+
+		// give output
+		const uint64_t out = start + delay;
+		for (size_t i = 0; i < P->portCount; i++) {
+			const auto desc = P->portDescriptors[i];
+			if (!IS_OUTPUT(desc)) continue;
+			if (IS_CONTROL(desc)) {
+				controls[i].store(local[i][0], std::memory_order_relaxed);
+				continue;
+			}
+			std::memcpy(rings[i].data() + out % ring, local[i].data(),
+				block * sizeof(sample_type));
+		}
+		outputEnd.store(out + block, std::memory_order_release);
+		start += block;
+	}
+}
+
+/*
+ * Outputs of skipped blocks are never written, so their part of the ring
+ * still has output of older blocks : host must get silence there.
+ * Host doesn't read after outputEnd, and it's not moved yet.
+ */
+void AsyncRunner::silence(uint64_t from, uint64_t to) {
+	const PluginProperties* P = H->P.get();
+	if (to - from > ring) from = to - ring;
+	const size_t off = from % ring;
+	const size_t n = to - from;
+	const size_t first = std::min(n, ring - off);
+	for (size_t i = 0; i < P->portCount; i++) {
+		const auto desc = P->portDescriptors[i];
+		if (!IS_OUTPUT(desc) || IS_CONTROL(desc)) continue;
+		sample_type* r = rings[i].data();
+		std::memset(r + off, 0, first * sizeof(sample_type));
+		std::memset(r, 0, (n - first) * sizeof(sample_type));
+	}
+}
+
+// n <= block, so rings never wrap more than once
+void AsyncRunner::hostChunk(sample_type* const* host, size_t offset, size_t n) {
+	const PluginProperties* P = H->P.get();
+	const uint64_t pos = hostPos;
+	const size_t off = pos % ring;
+	const size_t first = std::min(n, ring - off); // before wrap
+
+	for (size_t i = 0; i < P->portCount; i++) {
+		const auto desc = P->portDescriptors[i];
+		if (!IS_INPUT(desc) || IS_CONTROL(desc)) continue;
+		sample_type* r = rings[i].data();
+		if (!host[i]) {
+			std::memset(r + off, 0, first * sizeof(sample_type));
+			std::memset(r, 0, (n - first) * sizeof(sample_type));
+			continue;
+		}
+		const sample_type* src = host[i] + offset;
+		std::memcpy(r + off, src, first * sizeof(sample_type));
+		std::memcpy(r, src + first, (n - first) * sizeof(sample_type));
+	}
+	const uint64_t end = pos + n;
+	inputEnd.store(end, std::memory_order_release);
+	if (end / block != pos / block) cv.notify_one();
+
+	// output is ready or not
+	const bool ready = outputEnd.load(std::memory_order_acquire) >= end;
+	if (!ready) xruns++;
+	for (size_t i = 0; i < P->portCount; i++) {
+		const auto desc = P->portDescriptors[i];
+		if (!IS_OUTPUT(desc) || IS_CONTROL(desc) || !host[i]) continue;
+		sample_type* dst = host[i] + offset;
+		if (!ready) {
+			std::memset(dst, 0, n * sizeof(sample_type));
+			continue;
+		}
+		const sample_type* r = rings[i].data();
+		std::memcpy(dst, r + off, first * sizeof(sample_type));
+		std::memcpy(dst + first, r, (n - first) * sizeof(sample_type));
+	}
+	hostPos = end;
+}
+
+void RunAsync(PluginHandle* H, unsigned long samplecount) {
+	AsyncRunner* A = H->async.get();
+	const PluginProperties* P = H->P.get();
+	sample_type* const* host = H->connected.get();
+	if (samplecount > A->block && !A->warned) {
+		A->warned = true;
+		logError("Host block (%i) is bigger than async block (%i) of plugin %s,"
+			" expect silence!", (int)samplecount, (int)A->block, P->name);
+	}
+
+	for (size_t i = 0; i < P->portCount; i++) {
+		const auto desc = P->portDescriptors[i];
+		if (IS_CONTROL(desc) && IS_INPUT(desc) && host[i])
+			A->controls[i].store(*host[i], std::memory_order_relaxed);
+	}
+	for (size_t done = 0; done < samplecount; ) {
+		size_t n = std::min<size_t>(samplecount - done, A->block);
+		A->hostChunk(host, done, n);
+		done += n;
+	}
+	for (size_t i = 0; i < P->portCount; i++) {
+		const auto desc = P->portDescriptors[i];
+		if (!IS_CONTROL(desc) || !IS_OUTPUT(desc) || !host[i]) continue;
+		if ((int)i == P->latencyPort) *host[i] = (sample_type)PluginLatency(H);
+		else *host[i] = A->controls[i].load(std::memory_order_relaxed);
+	}
+}
@@ -18,11 +18,12 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include "lualadspa.hpp"
+#include <vector>
 #define BUFFNAME "_bufferMT"
 
 static inline void* getudata(lua_State* L) {
 	#if DEEP_DEBUG
-	return luaL_checkudata(L, 1, BUFFNAME)
+	return luaL_checkudata(L, 1, BUFFNAME);
 	#else
 	return lua_touserdata(L, 1); // no typechecks
 	#endif
@@ -30,7 +31,11 @@ static inline void* getudata(lua_State* L) {
 
 static int luaB_index(lua_State* L) {
 	LadspaBuffer* B = reinterpret_cast<LadspaBuffer*>(getudata(L));
-	int idx = luaL_checkinteger(L, 2) - 1;
+	if (UNLIKELY(!lua_isnumber(L, 2))) { // method
+		lua_rawget(L, lua_upvalueindex(1));
+		return 1;
+	}
+	int idx = lua_tointeger(L, 2) - 1;
 	sample_type *ptr = B->buffer + idx;
 
 	#if DEEP_DEBUG
@@ -47,6 +52,7 @@ static int luaB_newindex(lua_State* L) {
 	int idx = luaL_checkinteger(L, 2) - 1;
 	sample_type value = lua_tonumber(L, 3);
 	sample_type *ptr = B->buffer + idx;
+	if (UNLIKELY(B->readonly)) luaL_error(L, "buffer is readonly");
 
 	#if DEEP_DEBUG
 	if (UNLIKELY(idx < 0 || idx >= B->size)) luaL_error(L, "out of bounds");
@@ -57,6 +63,100 @@ static int luaB_newindex(lua_State* L) {
 	return 0;
 }
 
+static int luaB_len(lua_State* L) {
+	LadspaBuffer* B = reinterpret_cast<LadspaBuffer*>(getudata(L));
+	lua_pushinteger(L, B->size);
+	return 1;
+}
+
+/*
+ * buffer:view(offset, [len], [view])
+ * Returns external buffer, that aliases len samples of this one, starting
+ * after offset samples. Parent is kept alive while view is.
+ * Existing view may be passed to retarget it without allocations.
+ */
+static int luaB_view(lua_State* L) {
+	LadspaBuffer* P = CheckBuffer(L, 1);
+	int offset = luaL_checkinteger(L, 2);
+	int len = luaL_optinteger(L, 3, (int)P->size - offset);
+	if (offset < 0 || len < 0 || (size_t)offset + len > P->size)
+		luaL_error(L, "view is out of buffer bounds");
+	if (!P->buffer) luaL_error(L, "buffer is empty");
+	lua_settop(L, 4);
+
+	// views are keys of the registry "views" table (port and shared
+	// buffers are external too, but they are not views)
+	lua_getfield(L, LUA_REGISTRYINDEX, "views");
+	const int views = lua_gettop(L);
+	LadspaBuffer* V;
+	if (lua_isnil(L, 4)) V = NewBuffer(L, true);
+	else {
+		V = CheckBuffer(L, 4);
+		lua_pushvalue(L, 4);
+		if (V == P || lua_rawget(L, views) == LUA_TNIL)
+			luaL_error(L, "only views can be retargeted");
+		lua_pop(L, 1);
+		lua_pushvalue(L, 4);
+	}
+	V->buffer = P->buffer + offset;
+	V->size = len;
+	V->readonly = P->readonly;
+
+	// anchor parent (there is no userdata uservalues in luau)
+	lua_pushvalue(L, -1);
+	lua_pushvalue(L, 1);
+	lua_rawset(L, views);
+	return 1;
+}
+
+/*
+ * 4-wide access : vector lanes are 4 consecutive samples.
+ * Tail of the buffer is padded with zeroes on load, and not written on
+ * store, so loops with step 4 are always safe.
+ */
+static_assert(LUA_VECTOR_SIZE == 4, "lualadspa requires 4-wide luau vectors");
+
+static inline size_t checkIndex4(lua_State* L, LadspaBuffer* B, int idx) {
+	int i = luaL_checkinteger(L, idx) - 1;
+	if (UNLIKELY(i < 0 || (size_t)i >= B->size || !B->buffer))
+		luaL_error(L, "index is out of buffer bounds");
+	return i;
+}
+
+// buffer:load4(i) -> vector(buffer[i], ..., buffer[i+3])
+static int luaB_load4(lua_State* L) {
+	LadspaBuffer* B = CheckBuffer(L, 1);
+	size_t i = checkIndex4(L, B, 2);
+	const sample_type* p = B->buffer + i;
+	if (LIKELY(i + 4 <= B->size)) {
+		lua_pushvector(L, p[0], p[1], p[2], p[3]);
+		return 1;
+	}
+	float v[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	for (size_t k = 0; i + k < B->size; k++) v[k] = p[k];
+	lua_pushvector(L, v[0], v[1], v[2], v[3]);
+	return 1;
+}
+
+// buffer:store4(i, vector)
+static int luaB_store4(lua_State* L) {
+	LadspaBuffer* B = CheckOutBuffer(L, 1);
+	size_t i = checkIndex4(L, B, 2);
+	const float* v = lua_tovector(L, 3);
+	if (!v) luaL_typeerror(L, 3, "vector");
+	sample_type* p = B->buffer + i;
+	size_t n = B->size - i < 4 ? B->size - i : 4;
+	for (size_t k = 0; k < n; k++) p[k] = v[k];
+	return 0;
+}
+
+static const luaL_Reg buffer_methods[] = {
+	{"view", luaB_view},
+	{"load4", luaB_load4},
+	{"store4", luaB_store4},
+	{nullptr, nullptr}
+};
+
 static int luaP_version(lua_State* L) {
 	lua_pushnumber(L, version_major);
 	lua_pushnumber(L, version_minor);
@@ -68,6 +168,7 @@ static void buffdtor(lua_State* LL, void* p) {
 	if (B->external) return; // do not try to destroy external buffers!
 	LuaState& L = *reinterpret_cast<LuaState*>(lua_getthreaddata(LL));
 	L.limalloc(B->buffer, B->size * sizeof(sample_type), 0);
+	L.allocdata.buffers -= B->size * sizeof(sample_type);
 }
 
 LadspaBuffer* NewBuffer(lua_State* L, bool external) {	
@@ -77,49 +178,108 @@ LadspaBuffer* NewBuffer(lua_State* L, bool external) {
 	if (luaL_newmetatable(L, "_bufferMT")) {
 		lua_pushboolean(L, 0);
 		lua_setfield(L, -2, "__metatable");
-		lua_pushcfunction(L, luaB_index, "index");
+		lua_newtable(L); // methods
+		luaL_register(L, nullptr, buffer_methods);
+		lua_setreadonly(L, -1, true);
+		lua_pushcclosure(L, luaB_index, "index", 1);
 		lua_setfield(L, -2, "__index");
 		lua_pushcfunction(L, luaB_newindex, "newindex");
 		lua_setfield(L, -2, "__newindex");
+		lua_pushcfunction(L, luaB_len, "len");
+		lua_setfield(L, -2, "__len");
 	}
 	lua_setmetatable(L, -2);
 	LadspaBuffer* B = reinterpret_cast<LadspaBuffer*>(ud);
 	B->buffer = nullptr;
 	B->size = 0;
 	B->external = external;
+	B->readonly = false;
 	return B;
 }
 
-static int luaB_new(lua_State* LL) {
-	int n = luaL_optinteger(LL, 1, 0);
-	if (n < 0) n = 0;
+LadspaBuffer* CheckBuffer(lua_State* L, int idx) {
+	return reinterpret_cast<LadspaBuffer*>(luaL_checkudata(L, idx, BUFFNAME));
+}
+
+LadspaBuffer* CheckOutBuffer(lua_State* L, int idx) {
+	LadspaBuffer* B = CheckBuffer(L, idx);
+	if (B->readonly) luaL_error(L, "buffer #%i is readonly", idx);
+	return B;
+}
+
+void NewClass(lua_State* L, const char* name, const luaL_Reg* methods) {
+	luaL_newmetatable(L, name);
+	lua_pushboolean(L, 0);
+	lua_setfield(L, -2, "__metatable");
+	lua_newtable(L);
+	luaL_register(L, nullptr, methods);
+	lua_setreadonly(L, -1, true);
+	lua_setfield(L, -2, "__index");
+	lua_pop(L, 1);
+}
+
+LadspaBuffer* AllocBuffer(lua_State* LL, size_t n) {
 	LadspaBuffer* B = NewBuffer(LL, false);
-	LuaState& L = *reinterpret_cast<LuaState*>(lua_getthreaddata(LL));
+	LuaState& L = GetLuaState(LL);
 	if (n) {
 		B->buffer = reinterpret_cast<sample_type*> (L.limalloc(nullptr, 
 			0, n * sizeof(sample_type)));
 		if (!B->buffer) luaL_error(L, "NOMEM");
 		B->size = n;
+		L.allocdata.buffers += n * sizeof(sample_type);
 	}
+	return B;
+}
+
+static int luaB_new(lua_State* LL) {
+	int n = luaL_optinteger(LL, 1, 0);
+	if (n < 0) n = 0;
+	AllocBuffer(LL, n);
 	return 1;
 }
 
+// views point into storage of the buffer, so it can't be moved under them
+static bool hasViews(lua_State* L, LadspaBuffer* B) {
+	lua_getfield(L, LUA_REGISTRYINDEX, "views");
+	lua_pushnil(L);
+	while (lua_next(L, -2)) {
+		bool found = lua_touserdata(L, -1) == B;
+		lua_pop(L, 1);
+		if (found) {
+			lua_pop(L, 2);
+			return true;
+		}
+	}
+	lua_pop(L, 1);
+	return false;
+}
+
+void ResizeBuffer(lua_State* LL, LadspaBuffer* B, size_t n) {
+	LuaState& L = GetLuaState(LL);
+	if (B->external) luaL_error(LL, "Resizing external buffers is not allowed!");
+	if (n == B->size) return;
+	if (n && hasViews(LL, B)) {
+		lua_gc(LL, LUA_GCCOLLECT, 0); // dead views are kept until collected
+		if (hasViews(LL, B)) luaL_error(LL, "buffer with views can't be resized");
+	}
+	if (n) {
+		void* p = L.limalloc(B->buffer, B->size * sizeof(sample_type),
+			n * sizeof(sample_type));
+		if (!p) luaL_error(LL, "NOMEM"); // old buffer is still valid
+		L.allocdata.buffers -= B->size * sizeof(sample_type);
+		L.allocdata.buffers += n * sizeof(sample_type);
+		B->buffer = reinterpret_cast<sample_type*>(p);
+		B->size = n;
+	}
+}
+
 static int luaB_resize(lua_State* LL) {
 	int n = luaL_optinteger(LL, 2, 0);
 	if (n < 0) n = 0;
 	LadspaBuffer* B = reinterpret_cast<LadspaBuffer*> (
 			luaL_checkudata(LL, 1, BUFFNAME));
-	LuaState& L = *reinterpret_cast<LuaState*>(lua_getthreaddata(LL));
-	if (!B->external) luaL_error(L, "Resizing external buffers is not allowed!");
-	if (n) {
-		B->buffer = reinterpret_cast<sample_type*>( L.limalloc(B->buffer,
-			B->size * sizeof(sample_type),
-			n * sizeof(sample_type)
-		));
-		if (!B->buffer) luaL_error(L, "NOMEM");
-		B->size = n;
-	}
-	lua_pushboolean(L, 1);
+	ResizeBuffer(LL, B, n);
+	lua_pushboolean(LL, 1);
 	return 1;
 }
 
@@ -134,17 +294,158 @@ static int luaP_getrate(lua_State* L) {
 	return 1;
 }
 
+// ladspa.vector(x, [y, z, w]), one argument fills all lanes
+static int luaP_vector(lua_State* L) {
+	float x = luaL_checknumber(L, 1);
+	if (lua_isnoneornil(L, 2)) {
+		lua_pushvector(L, x, x, x, x);
+		return 1;
+	}
+	lua_pushvector(L, x, luaL_checknumber(L, 2), luaL_optnumber(L, 3, 0.0),
+		luaL_optnumber(L, 4, 0.0));
+	return 1;
+}
+
+// ladspa.clamp4(vector, min, max) - lane-wise clamp
+static int luaP_clamp4(lua_State* L) {
+	const float* v = lua_tovector(L, 1);
+	if (!v) luaL_typeerror(L, 1, "vector");
+	float lo = luaL_checknumber(L, 2);
+	float hi = luaL_checknumber(L, 3);
+	float r[4];
+	for (int k = 0; k < 4; k++) r[k] = v[k] < lo ? lo : (v[k] > hi ? hi : v[k]);
+	lua_pushvector(L, r[0], r[1], r[2], r[3]);
+	return 1;
+}
+
+/*
+ * Shared data : native arrays, published once per plugin type
+ * (normally by the master state) and referenced by all instances
+ * through readonly buffers, without copying.
+ */
+using SharedData = std::vector<sample_type>;
+
+static void pushShared(lua_State* L, const SharedData& D) {
+	LadspaBuffer* B = NewBuffer(L, true);
+	B->buffer = const_cast<sample_type*>(D.data()); // readonly!
+	B->size = D.size();
+	B->readonly = true;
+}
+
+// copies buffer or array of numbers at idx
+static std::shared_ptr<const SharedData> makeShared(lua_State* L, int idx) {
+	auto D = std::make_shared<SharedData>();
+	if (lua_istable(L, idx)) {
+		int n = lua_objlen(L, idx);
+		D->resize(n);
+		for (int i = 1; i <= n; i++) {
+			lua_rawgeti(L, idx, i);
+			(*D)[i-1] = lua_tonumber(L, -1);
+			lua_pop(L, 1);
+		}
+	} else {
+		LadspaBuffer* B = CheckBuffer(L, idx);
+		if (B->buffer) D->assign(B->buffer, B->buffer + B->size);
+	}
+	if (D->empty()) luaL_error(L, "shared data is empty");
+	return D;
+}
+
+/*
+ * ladspa.share(name, data) -> readonly buffer
+ * data is a buffer, array of numbers or function returning one of them.
+ * Function is called only if data with this name was not shared yet.
+ */
+static int luaP_share(lua_State* L) {
+	const char* name = luaL_checkstring(L, 1);
+	lua_settop(L, 2);
+	PluginProperties* P = GetProperties(L);
+	if (!P) luaL_error(L, "no plugin properties");
+	auto D = SharedResource<SharedData>(P, strformat("data:%s", name), [L] () {
+		lua_pushvalue(L, 2);
+		if (lua_isfunction(L, -1)) lua_call(L, 0, 1);
+		auto res = makeShared(L, lua_gettop(L));
+		lua_pop(L, 1);
+		return res;
+	});
+	pushShared(L, *D);
+	return 1;
+}
+
+// ladspa.shared(name) -> readonly buffer or nil
+static int luaP_shared(lua_State* L) {
+	const char* name = luaL_checkstring(L, 1);
+	auto D = FindResource<SharedData>(GetProperties(L),
+		strformat("data:%s", name));
+	if (!D) return 0;
+	pushShared(L, *D);
+	return 1;
+}
+
+/*
+ * Latency of the plugin processing, in samples of getSampleRate().
+ * Host gets it through "latency" output control port, with
+ * oversampling filters delay added.
+ */
+static int luaP_setlatency(lua_State* L) {
+	int n = luaL_checkinteger(L, 1);
+	PluginHandle* H = GetHandle(L);
+	if (!H) luaL_error(L, "latency can be set only by plugin instance");
+	if (H->chain) SetChainLatency(H, n > 0 ? n : 0);
+	else H->latency = n > 0 ? n : 0;
+	return 0;
+}
+
+// ladspa.setFlushDenormals(bool) : FTZ/DAZ around run() of this instance
+static int luaP_setflush(lua_State* L) {
+	PluginHandle* H = GetHandle(L);
+	if (!H) luaL_error(L, "can be set only by plugin instance");
+	H->flushDenormals.store(lua_toboolean(L, 1), std::memory_order_relaxed);
+	return 0;
+}
+
+// total latency in host samples (as reported to the host)
+static int luaP_getlatency(lua_State* L) {
+	PluginHandle* H = GetHandle(L);
+	if (!H) return 0;
+	lua_pushinteger(L, PluginLatency(H));
+	return 1;
+}
+
 static const luaL_Reg ladspa_funcs[] = {
 	{"getVersion", luaP_version},
 	{"newBuffer", luaB_new},
 	{"resizeBuffer", luaB_resize},
 	{"getSampleRate", luaP_getrate},
 	{"getMemoryUsage", luaP_getusage},
+	{"setLatency", luaP_setlatency},
+	{"getLatency", luaP_getlatency},
+	{"setFlushDenormals", luaP_setflush},
+	{"vector", luaP_vector},
+	{"share", luaP_share},
+	{"shared", luaP_shared},
+	{"clamp4", luaP_clamp4},
+	{"load4", luaB_load4},
+	{"store4", luaB_store4},
 	{nullptr, nullptr}
 };
 
 void OpenLuaLadspa(lua_State* L) {
 	lua_setuserdatadtor(L, 24, buffdtor);
+	// view -> parent buffer
+	lua_newtable(L);
+	lua_newtable(L);
+	lua_pushstring(L, "k");
+	lua_setfield(L, -2, "__mode");
+	lua_setmetatable(L, -2);
+	lua_setfield(L, LUA_REGISTRYINDEX, "views");
 	luaL_register(L, "ladspa", ladspa_funcs);
 	lua_pop(L, 1);
+	OpenLuaFFT(L);
+	OpenLuaOscillator(L);
+	OpenLuaDynamics(L);
+	OpenLuaWorker(L);
+	OpenLuaMessages(L);
+	OpenLuaMemory(L);
+	OpenLuaModules(L);
 }
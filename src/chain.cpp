@@ -0,0 +1,303 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Chain plugins : several plugins in one lua state, as one LADSPA plugin
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "fileIO.hpp"
+
+/*
+ * Chain manifest is a plugin file with `chain` array of plugin files
+ * instead of ports and callbacks. Stages are loaded as usual plugins in
+ * the master state (to check them and get their ports), but instance
+ * runs all of them in it's own lua state, each one in it's own
+ * environment table. Audio outputs of each stage are connected to audio
+ * inputs of the next one through internal buffers, so only audio inputs
+ * of the first stage, audio outputs of the last one and control ports of
+ * all stages are exposed to the host.
+ */
+
+class ChainState {
+	public:
+	std::vector<int> envs; // refs of stage environments
+	std::vector<size_t> latency; // of each stage
+	std::vector<size_t> mainLatency; // after main chunks, for the pool
+	size_t current = 0; // stage running now (for ladspa.setLatency())
+	// audio links after each stage (but the last one). Links after even
+	// and odd stages use two banks of the same storage, so it stays small
+	// and hot in cache whatever the chain length is.
+	// Allocated by instantiate() for chain_block samples per link, bigger
+	// blocks are processed in parts, so run() never allocates.
+	std::vector<std::vector<LadspaBuffer*>> links;
+	std::vector<sample_type> storage;
+	// audio ports of the chain (host or oversampler data), for parts
+	std::vector<sample_type*> ports;
+	sample_type hidden = 0; // latency ports of the stages
+};
+
+void ChainStateDeleter::operator()(ChainState* C) const {
+	delete C; // lua state is closed after, it keeps the buffers
+}
+
+// port description in the same format as in plugin ports table
+void PushPortDescription(lua_State* L, const PluginProperties* S, size_t i,
+		const char* prefix) {
+	const auto desc = S->portDescriptors[i];
+	const auto& R = S->portRangeHints[i];
+	const auto hint = R.HintDescriptor;
+	lua_createtable(L, 0, 6);
+	lua_pushstring(L, IS_INPUT(desc) ? (IS_CONTROL(desc) ? "ic" : "ia") :
+		(IS_CONTROL(desc) ? "oc" : "oa"));
+	lua_setfield(L, -2, "type");
+	if (prefix) lua_pushfstring(L, "%s: %s", prefix, S->portNames[i]);
+	else lua_pushstring(L, S->portNames[i]);
+	lua_setfield(L, -2, "name");
+	if (LADSPA_IS_HINT_BOUNDED_BELOW(hint)) {
+		lua_pushnumber(L, R.LowerBound);
+		lua_setfield(L, -2, "min");
+	}
+	if (LADSPA_IS_HINT_BOUNDED_ABOVE(hint)) {
+		lua_pushnumber(L, R.UpperBound);
+		lua_setfield(L, -2, "max");
+	}
+	std::string hints;
+	if (LADSPA_IS_HINT_TOGGLED(hint)) hints = "bool";
+	if (LADSPA_IS_HINT_LOGARITHMIC(hint)) hints += " log";
+	if (LADSPA_IS_HINT_INTEGER(hint)) hints += " int";
+	if (LADSPA_IS_HINT_SAMPLE_RATE(hint)) hints += " freq";
+	lua_pushstring(L, hints.c_str());
+	lua_setfield(L, -2, "hint");
+	const char* def = nullptr;
+	switch (hint & LADSPA_HINT_DEFAULT_MASK) {
+		case LADSPA_HINT_DEFAULT_MINIMUM: def = "min"; break;
+		case LADSPA_HINT_DEFAULT_LOW: def = "low"; break;
+		case LADSPA_HINT_DEFAULT_MIDDLE: def = "middle"; break;
+		case LADSPA_HINT_DEFAULT_HIGH: def = "high"; break;
+		case LADSPA_HINT_DEFAULT_MAXIMUM: def = "max"; break;
+	}
+	if (def) {
+		lua_pushstring(L, def);
+		lua_setfield(L, -2, "default");
+	}
+}
+
+// (props, manifest file name) : loads stages, sets ports global
+static int lchain_load(lua_State* L) {
+	PluginProperties* P = reinterpret_cast<PluginProperties*>
+		(lua_tolightuserdata(L, 1));
+	const fsys::path dir = fsys::path(lua_tostring(L, 2)).parent_path();
+	lua_settop(L, 0);
+	if (lua_getfield(L, LUA_GLOBALSINDEX, "chain") != LUA_TTABLE)
+		luaL_error(L, "chain must be an array of plugin files!");
+	if (lua_getfield(L, LUA_GLOBALSINDEX, "ports") != LUA_TNIL)
+		luaL_error(L, "chain plugin can't have it's own ports!");
+	if (lua_getfield(L, LUA_GLOBALSINDEX, "info") == LUA_TTABLE) {
+		lua_getfield(L, -1, "worker");
+		if (lua_toboolean(L, -1)) luaL_error(L, "chain plugin can't have a worker!");
+	}
+	lua_settop(L, 1);
+	const int n = lua_objlen(L, 1);
+	if (n < 1) luaL_error(L, "chain is empty!");
+
+	lua_newtable(L); // 2 : ports of the chain
+	bool latency = false;
+	size_t prevOuts = 0;
+	for (int s = 1; s <= n; s++) {
+		// "file.lua" or {file = "file.lua", name = "prefix of port names"}
+		std::string file, prefix;
+		lua_rawgeti(L, 1, s);
+		if (lua_istable(L, -1)) {
+			lua_getfield(L, -1, "name");
+			if (lua_isstring(L, -1)) prefix = lua_tostring(L, -1);
+			lua_getfield(L, -2, "file");
+		}
+		if (!lua_isstring(L, -1)) luaL_error(L, "bad chain stage %i!", s);
+		file = lua_tostring(L, -1);
+		lua_settop(L, 2);
+
+		PlugPropShared S = LoadPlugin((dir / file).string().c_str());
+		if (!S) luaL_error(L, "can't load chain stage %s!", file.c_str());
+		if (!S->stages.empty() || S->graph)
+			luaL_error(L, "chain stage %s is a chain or graph!", file.c_str());
+		if (S->oversample > 1 || S->async || S->worker || S->channels)
+			luaL_error(L, "chain stage %s can't use oversample, async, worker "
+				"or channel groups!", file.c_str());
+		if (prefix.empty()) prefix = S->label;
+
+		ChainStage stage;
+		stage.props = S;
+		size_t ins = 0, outs = 0;
+		for (size_t i = 0; i < S->portCount; i++) {
+			const auto desc = S->portDescriptors[i];
+			int idx;
+			if ((int)i == S->latencyPort) { // summed into one latency port
+				idx = chain_hidden;
+				latency = true;
+			} else if (IS_AUDIO(desc) && IS_INPUT(desc) && s > 1) {
+				idx = -(int)(ins++) - 2;
+			} else if (IS_AUDIO(desc) && IS_OUTPUT(desc) && s < n) {
+				idx = -(int)(outs++) - 2;
+			} else {
+				idx = lua_objlen(L, 2);
+				PushPortDescription(L, S.get(), i,
+					IS_CONTROL(desc) ? prefix.c_str() : nullptr);
+				lua_rawseti(L, 2, idx + 1);
+			}
+			stage.ports.push_back(idx);
+		}
+		if (s > 1 && ins != prevOuts)
+			luaL_error(L, "chain stage %s has %i audio inputs, but previous one "
+				"has %i audio outputs!", file.c_str(), (int)ins, (int)prevOuts);
+		prevOuts = outs;
+		if (outs > P->chainWidth) P->chainWidth = outs;
+		P->stages.push_back(std::move(stage));
+	}
+
+	if (latency) {
+		lua_createtable(L, 0, 2);
+		lua_pushstring(L, "oc");
+		lua_setfield(L, -2, "type");
+		lua_pushstring(L, "latency");
+		lua_setfield(L, -2, "name");
+		lua_rawseti(L, 2, lua_objlen(L, 2) + 1);
+	}
+	lua_setfield(L, LUA_GLOBALSINDEX, "ports"); // parsed as usual after
+	return 0;
+}
+
+bool LoadChain(LuaState& L, PluginProperties* props, const char* name) {
+	lua_pushcfunction(L, lchain_load, "loadChain");
+	lua_pushlightuserdata(L, props);
+	lua_pushstring(L, name);
+	return lua_pcall(L, 2, 0, 0) == LUA_OK;
+}
+
+// (handle) : runs main chunks of the stages and makes their buffers
+static int lchain_instance(lua_State* L) {
+	PluginHandle* H = reinterpret_cast<PluginHandle*>(lua_tolightuserdata(L, 1));
+	ChainState* C = H->chain.get();
+	const auto& stages = H->P->stages;
+	const size_t width = H->P->chainWidth;
+	lua_settop(L, 0);
+	C->latency.assign(stages.size(), 0);
+	C->links.assign(stages.size() - 1, std::vector<LadspaBuffer*>(width));
+	C->storage.assign(2 * width * chain_block, 0.0f);
+	C->ports.assign(H->P->portCount, nullptr);
+
+	for (size_t s = 0; s < stages.size(); s++) {
+		const PluginProperties* S = stages[s].props.get();
+		lua_createtable(L, 0, 8); // globals of the stage
+		lua_createtable(L, 0, 1);
+		lua_pushvalue(L, LUA_GLOBALSINDEX);
+		lua_setfield(L, -2, "__index"); // shared libraries
+		lua_setreadonly(L, -1, true);
+		lua_setmetatable(L, -2);
+		lua_pushvalue(L, -1);
+		lua_setfield(L, -2, "_G");
+		lua_setsafeenv(L, -1, true);
+		if (!GetLuaState(L).loadBytecode(*S->bytecode, S->name, lua_gettop(L)))
+			lua_error(L);
+		C->current = s;
+		lua_call(L, 0, 0);
+		C->envs.push_back(lua_ref(L, -1));
+		lua_pop(L, 1);
+	}
+	C->mainLatency = C->latency;
+
+	if (!InitInstanceBuffers(L, H)) luaL_error(L, "can't make buffers!");
+	lua_getfield(L, LUA_REGISTRYINDEX, "buffers"); // 1 : ports of the chain
+	lua_newtable(L); // 2 : audio links, by (stage * width + k + 1)
+	for (size_t s = 0; s < stages.size(); s++) {
+		const ChainStage& stage = stages[s];
+		const PluginProperties* S = stage.props.get();
+		lua_createtable(L, S->portCount, 0);
+		for (size_t i = 0; i < S->portCount; i++) {
+			const int idx = stage.ports[i];
+			if (idx >= 0) {
+				lua_rawgeti(L, 1, idx + 1);
+			} else if (idx == chain_hidden) {
+				LadspaBuffer* B = NewBuffer(L, true);
+				B->buffer = &C->hidden;
+				B->size = 1;
+			} else if (IS_OUTPUT(S->portDescriptors[i])) { // to the next stage
+				const size_t k = -idx - 2;
+				C->links[s][k] = NewBuffer(L, true);
+				lua_pushvalue(L, -1);
+				lua_rawseti(L, 2, s * width + k + 1);
+			} else { // from the previous one
+				lua_rawgeti(L, 2, (s - 1) * width + (-idx - 2) + 1);
+			}
+			lua_rawseti(L, -2, i + 1);
+		}
+		lua_setreadonly(L, -1, true);
+		lua_getref(L, C->envs[s]);
+		lua_insert(L, -2);
+		lua_setfield(L, -2, "buffers");
+		lua_pop(L, 1);
+	}
+	return 0;
+}
+
+bool LoadChainInstance(PluginHandle* H) {
+	H->chain.reset(new ChainState);
+	LuaState& L = H->L;
+	lua_pushcfunction(L, lchain_instance, "loadChainInstance");
+	lua_pushlightuserdata(L, H);
+	return lua_pcall(L, 1, 0, 0) == LUA_OK;
+}
+
+void PushStage(PluginHandle* H, size_t stage) {
+	ChainState* C = H->chain.get();
+	C->current = stage;
+	lua_getref(H->L, C->envs[stage]);
+}
+
+void PrepareChain(PluginHandle* H, unsigned long offset, unsigned long samplecount) {
+	ChainState* C = H->chain.get();
+	const PluginProperties* P = H->P.get();
+	const size_t width = P->chainWidth;
+	for (size_t i = 0; i < P->portCount; i++) {
+		if (IS_CONTROL(P->portDescriptors[i])) continue;
+		LadspaBuffer* B = H->ports[i];
+		if (!offset) C->ports[i] = B->buffer; // first part
+		B->buffer = C->ports[i] ? C->ports[i] + offset : nullptr;
+		B->size = samplecount;
+	}
+	for (size_t s = 0; s < C->links.size(); s++) {
+		sample_type* bank = C->storage.data() + (s & 1) * width * chain_block;
+		for (size_t k = 0; k < width; k++) {
+			LadspaBuffer* B = C->links[s][k];
+			if (!B) continue;
+			B->buffer = bank + k * chain_block;
+			B->size = samplecount;
+		}
+	}
+}
+
+void RestoreChainLatency(PluginHandle* H) {
+	ChainState* C = H->chain.get();
+	C->latency = C->mainLatency; // same size, no allocation
+	H->latency = 0;
+	for (size_t l : C->latency) H->latency += l;
+}
+
+void SetChainLatency(PluginHandle* H, size_t latency) {
+	ChainState* C = H->chain.get();
+	C->latency[C->current] = latency;
+	H->latency = 0; // stages are sequential
+	for (size_t l : C->latency) H->latency += l;
+}
@@ -20,6 +20,7 @@
  */
 
 #include "ladspa.h"
+#include "lualadspa_c.h"
 
 //extern "C" const LADSPA_Descriptor* ladspa_descriptor(unsigned long Index);
 
@@ -27,6 +28,12 @@
 #include <string>
 #include <cstdarg>
 #include <memory>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+#include <chrono>
+#include <map>
+#include <vector>
 
 FILE* outlog = stderr;
 
@@ -68,6 +75,11 @@ void logInfo(const char* message, ...) {
 
 typedef FILE* (*logSetter)(FILE* f);
 
+// slot of removed or broken plugin, kept to not shift indices of others
+static bool isPlaceholder(const LADSPA_Descriptor* D) {
+	return !D->ImplementationData;
+}
+
 float getDefault(LADSPA_PortRangeHint desc) {
 	float min = desc.LowerBound;
 	float max = desc.UpperBound;
@@ -77,6 +89,329 @@ float getDefault(LADSPA_PortRangeHint desc) {
 	if (h & LADSPA_HINT_DEFAULT_MIDDLE) return (max - min)/2.0;
 }
 
+/*
+ * lualadspa top : shows stats of all plugin instances in all processes,
+ * read from shared memory telemetry segments (see lualadspa_c.h)
+ */
+#if defined(__linux__) | defined(__unix__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+// consistent copy of the slot (seqlock reader)
+static bool readSlot(const lualadspa_stats* src, lualadspa_stats& dst) {
+	for (int tries = 0; tries < 1000; tries++) {
+		uint32_t seq = __atomic_load_n(&src->seq, __ATOMIC_ACQUIRE);
+		if (seq & 1) continue;
+		std::memcpy(&dst, src, sizeof(dst));
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&src->seq, __ATOMIC_RELAXED) == seq) return true;
+	}
+	return false;
+}
+
+// upper bound of histogram percentile, in microseconds
+static double percentile(const uint64_t* hist, double p) {
+	uint64_t total = 0;
+	for (int i = 0; i < LUALADSPA_TELEMETRY_BUCKETS; i++) total += hist[i];
+	if (!total) return 0.0;
+	uint64_t need = (uint64_t)std::ceil(total * p), sum = 0;
+	int i = 0;
+	for (; i < LUALADSPA_TELEMETRY_BUCKETS - 1; i++) {
+		sum += hist[i];
+		if (sum >= need) break;
+	}
+	return std::pow(2.0, (i + 1) / 2.0);
+}
+
+struct TopEntry {
+	int pid;
+	lualadspa_stats now;
+};
+
+static void collectStats(std::vector<TopEntry>& out) {
+	out.clear();
+	DIR* dir = opendir("/dev/shm");
+	if (!dir) return;
+	const char* prefix = LUALADSPA_TELEMETRY_PREFIX + 1; // without '/'
+	while (dirent* e = readdir(dir)) {
+		if (std::strncmp(e->d_name, prefix, std::strlen(prefix)) != 0) continue;
+		std::string name = std::string("/") + e->d_name;
+		int fd = shm_open(name.c_str(), O_RDONLY, 0);
+		if (fd < 0) continue;
+		void* p = mmap(nullptr, sizeof(lualadspa_telemetry), PROT_READ,
+			MAP_SHARED, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED) continue;
+		auto T = reinterpret_cast<const lualadspa_telemetry*>(p);
+		// dead processes may leave segment (if they crashed)
+		if (__atomic_load_n(&T->magic, __ATOMIC_ACQUIRE) ==
+				LUALADSPA_TELEMETRY_MAGIC &&
+				T->version == LUALADSPA_TELEMETRY_VERSION &&
+				kill(T->pid, 0) == 0) {
+			for (uint32_t i = 0; i < T->slots && i < LUALADSPA_TELEMETRY_SLOTS; i++) {
+				TopEntry t;
+				t.pid = T->pid;
+				if (readSlot(T->stats + i, t.now) && t.now.active) out.push_back(t);
+			}
+		}
+		munmap(p, sizeof(lualadspa_telemetry));
+	}
+	closedir(dir);
+}
+
+static int runTop(bool once) {
+	std::map<std::pair<int, uint64_t>, lualadspa_stats> prev;
+	std::vector<TopEntry> list;
+	while (true) {
+		collectStats(list);
+		if (!once) printf("\033[H\033[2J");
+		printf("%7s %5s %-16s %10s %6s %8s %8s %8s %9s %9s %9s %8s %9s %6s %s\n",
+			"PID", "ID", "LABEL", "BLOCKS", "DSP%", "p50us", "p90us", "p99us",
+			"MEM KB", "PEAK KB", "LIMIT KB", "GC ms", "RUNALLOC", "ERR", "STATE");
+		std::map<std::pair<int, uint64_t>, lualadspa_stats> next;
+		for (auto& t : list) {
+			const lualadspa_stats& S = t.now;
+			auto key = std::make_pair(t.pid, S.id);
+			// percentiles and load of the last interval, if it's known
+			uint64_t hist[LUALADSPA_TELEMETRY_BUCKETS];
+			double runtime = S.run_time;
+			uint64_t samples = S.samples;
+			auto it = prev.find(key);
+			for (int i = 0; i < LUALADSPA_TELEMETRY_BUCKETS; i++)
+				hist[i] = S.run_hist[i] - (it != prev.end() ? it->second.run_hist[i] : 0);
+			if (it != prev.end()) {
+				runtime -= it->second.run_time;
+				samples -= it->second.samples;
+			}
+			double audio = S.samplerate ? (double)samples / S.samplerate : 0.0;
+			printf("%7i %5llu %-16.16s %10llu %6.1f %8.0f %8.0f %8.0f %9llu %9llu"
+				" %9llu %8.1f %9llu %6llu %s\n", t.pid, (unsigned long long)S.id,
+				S.label, (unsigned long long)S.blocks,
+				audio > 0 ? runtime / audio * 100.0 : 0.0,
+				percentile(hist, 0.5), percentile(hist, 0.9), percentile(hist, 0.99),
+				(unsigned long long)S.memory >> 10,
+				(unsigned long long)S.memory_peak >> 10,
+				(unsigned long long)S.memory_limit >> 10, S.gc_time * 1000.0,
+				(unsigned long long)S.run_allocations,
+				(unsigned long long)S.errors, S.shutdown ? "DEAD" : "ok");
+			next[key] = S;
+		}
+		if (list.empty()) printf("No running lualadspa instances.\n");
+		fflush(stdout);
+		if (once) return 0;
+		prev.swap(next);
+		sleep(1);
+	}
+}
+#else
+static int runTop(bool once) {
+	logError("lualadspa top is not supported on this platform!");
+	return -1;
+}
+#endif
+
+/*
+ * lualadspa alloccheck [blocks] : runs each plugin for some blocks after
+ * warmup and reports plugins, that allocate memory in run().
+ * Returns 1 if there are any.
+ */
+typedef int (*memoryStatsGetter)(LADSPA_Handle, struct lualadspa_memory_stats*);
+typedef int (*errorsGetter)(LADSPA_Handle, uint64_t*, int*);
+
+constexpr int check_block = 256;
+constexpr int check_warmup = 32; // blocks (more than default info.warmup)
+
+// value of control port from it's default hint (as hosts do)
+static float controlDefault(const LADSPA_PortRangeHint& hint, unsigned long rate) {
+	const int h = hint.HintDescriptor;
+	float lo = hint.LowerBound, hi = hint.UpperBound;
+	if (LADSPA_IS_HINT_SAMPLE_RATE(h)) {
+		lo *= rate;
+		hi *= rate;
+	}
+	const bool lg = LADSPA_IS_HINT_LOGARITHMIC(h) && lo > 0 && hi > 0;
+	auto mix = [&] (float k) {
+		return lg ? std::exp(std::log(lo) * (1 - k) + std::log(hi) * k) :
+			lo * (1 - k) + hi * k;
+	};
+	switch (h & LADSPA_HINT_DEFAULT_MASK) {
+	case LADSPA_HINT_DEFAULT_MINIMUM: return lo;
+	case LADSPA_HINT_DEFAULT_LOW: return mix(0.25f);
+	case LADSPA_HINT_DEFAULT_MIDDLE: return mix(0.5f);
+	case LADSPA_HINT_DEFAULT_HIGH: return mix(0.75f);
+	case LADSPA_HINT_DEFAULT_MAXIMUM: return hi;
+	case LADSPA_HINT_DEFAULT_0: return 0.0f;
+	case LADSPA_HINT_DEFAULT_1: return 1.0f;
+	case LADSPA_HINT_DEFAULT_100: return 100.0f;
+	case LADSPA_HINT_DEFAULT_440: return 440.0f;
+	}
+	if (LADSPA_IS_HINT_BOUNDED_BELOW(h)) return lo;
+	return LADSPA_IS_HINT_BOUNDED_ABOVE(h) && hi < 0 ? hi : 0.0f;
+}
+
+// connects all ports to buffers, controls get default values
+static void connectTestPorts(const LADSPA_Descriptor* D, LADSPA_Handle inst,
+		std::vector<std::vector<LADSPA_Data>>& bufs, unsigned long rate) {
+	bufs.assign(D->PortCount, {});
+	for (unsigned long i = 0; i < D->PortCount; i++) {
+		if (LADSPA_IS_PORT_AUDIO(D->PortDescriptors[i]))
+			bufs[i].assign(check_block, 0.0f);
+		else bufs[i].assign(1, controlDefault(D->PortRangeHints[i], rate));
+		D->connect_port(inst, i, bufs[i].data());
+	}
+}
+
+static int allocCheck(LADSPA_Descriptor_Function ladspa_descriptor,
+		memoryStatsGetter getStats, errorsGetter getErrors, int blocks) {
+	if (!getStats || !getErrors) {
+		logError("This liblualadspa has no memory stats!");
+		return -1;
+	}
+	int bad = 0, ind = 0;
+	const LADSPA_Descriptor* D;
+	while ((D = ladspa_descriptor(ind++)) != nullptr) {
+		if (isPlaceholder(D)) {
+			printf("%-24s not available\n", D->Label);
+			continue;
+		}
+		auto inst = D->instantiate(D, 48000);
+		if (!inst) {
+			printf("%-24s CAN'T INSTANTIATE\n", D->Label);
+			bad++;
+			continue;
+		}
+		std::vector<std::vector<LADSPA_Data>> bufs;
+		connectTestPorts(D, inst, bufs, 48000);
+		for (unsigned long i = 0; i < D->PortCount; i++) {
+			if (!LADSPA_IS_PORT_AUDIO(D->PortDescriptors[i])) continue;
+			for (int k = 0; k < check_block; k++) // some signal
+				bufs[i][k] = 0.5f * std::sin(k * 0.0576f);
+		}
+		D->activate(inst);
+		struct lualadspa_memory_stats before, after;
+		for (int b = 0; b < check_warmup; b++) D->run(inst, check_block);
+		getStats(inst, &before);
+		for (int b = 0; b < blocks; b++) D->run(inst, check_block);
+		getStats(inst, &after);
+		// plugin, that fails in run(), does not allocate there either
+		uint64_t errors = 0;
+		int terminated = 0;
+		getErrors(inst, &errors, &terminated);
+		D->deactivate(inst);
+		D->cleanup(inst);
+
+		const auto n = after.run_allocations - before.run_allocations;
+		const auto bytes = after.run_bytes - before.run_bytes;
+		if (terminated || errors) {
+			printf("%-24s FAIL : %s%llu errors\n", D->Label,
+				terminated ? "terminated, " : "", (unsigned long long)errors);
+			bad++;
+		} else if (n) {
+			printf("%-24s FAIL : %llu allocations (%llu bytes) in %i blocks\n",
+				D->Label, (unsigned long long)n, (unsigned long long)bytes, blocks);
+			bad++;
+		} else printf("%-24s ok\n", D->Label);
+	}
+	return bad ? 1 : 0;
+}
+
+/*
+ * lualadspa bench [label [blocks]] : run() time of plugins on decaying
+ * tail (impulse, and then input slowly decaying through subnormal range,
+ * as reverb and filter tails do), with and without flushing denormals.
+ */
+typedef void (*flushSetter)(LADSPA_Handle, int);
+
+// returns microseconds per block
+static double benchTail(const LADSPA_Descriptor* D, flushSetter setFlush,
+		bool flush, int blocks) {
+	auto inst = D->instantiate(D, 48000);
+	if (!inst) return -1.0;
+	std::vector<std::vector<LADSPA_Data>> bufs;
+	connectTestPorts(D, inst, bufs, 48000);
+	setFlush(inst, flush);
+	D->activate(inst);
+
+	// 1e-36 .. 1e-46 (float subnormals are below 1.2e-38)
+	const double total = (double)blocks * check_block;
+	const double decay = std::log(1e10) / total;
+	std::chrono::steady_clock::duration spent{0};
+	for (int b = 0; b < blocks; b++) {
+		for (unsigned long i = 0; i < D->PortCount; i++) {
+			const auto desc = D->PortDescriptors[i];
+			if (!LADSPA_IS_PORT_AUDIO(desc) || !LADSPA_IS_PORT_INPUT(desc)) continue;
+			for (int k = 0; k < check_block; k++) {
+				const double n = (double)b * check_block + k;
+				bufs[i][k] = n == 0 ? 1.0f : (float)(1e-36 * std::exp(-n * decay));
+			}
+		}
+		auto start = std::chrono::steady_clock::now();
+		D->run(inst, check_block);
+		spent += std::chrono::steady_clock::now() - start;
+	}
+	D->deactivate(inst);
+	D->cleanup(inst);
+	return std::chrono::duration<double, std::micro>(spent).count() / blocks;
+}
+
+static int bench(LADSPA_Descriptor_Function ladspa_descriptor,
+		flushSetter setFlush, const char* label, int blocks) {
+	if (!setFlush) {
+		logError("This liblualadspa can't flush denormals!");
+		return -1;
+	}
+	int ind = 0, found = 0;
+	const LADSPA_Descriptor* D;
+	while ((D = ladspa_descriptor(ind++)) != nullptr) {
+		if (label && std::strcmp(label, D->Label) != 0) continue;
+		if (isPlaceholder(D)) continue;
+		found++;
+		double off = benchTail(D, setFlush, false, blocks);
+		double on = benchTail(D, setFlush, true, blocks);
+		if (off < 0 || on < 0) {
+			printf("%-24s CAN'T INSTANTIATE\n", D->Label);
+			continue;
+		}
+		printf("%-24s flush off %9.2f us/block, flush on %9.2f us/block (%.2fx)\n",
+			D->Label, off, on, on > 0 ? off / on : 0.0);
+	}
+	if (!found) logError("No plugin %s!", label ? label : "");
+	return found ? 0 : -1;
+}
+
+typedef void* (*stateSaver)(LADSPA_Handle, size_t*);
+typedef int (*stateLoader)(LADSPA_Handle, const void*, size_t);
+typedef void (*stateFree)(void*);
+
+/*
+ * lualadspa list [text] : plugin files from the plugin database, with
+ * their slots, ids and errors (only ones with text in file, label or name)
+ */
+typedef size_t (*pluginLister)(lualadspa_plugin_cb, void*);
+
+static void printPlugin(const struct lualadspa_plugin_info* P, void* ud) {
+	const char* text = reinterpret_cast<const char*>(ud);
+	auto has = [text] (const char* s) { return s && std::strstr(s, text); };
+	if (text && !has(P->file) && !has(P->label) && !has(P->name)) return;
+	const std::string index = P->index >= 0 ? std::to_string(P->index) : "-";
+	printf("%5s %8lu %-24s %5lu %s\n", index.c_str(), P->id,
+		P->label ? P->label : "-", P->ports, P->file ? P->file : "-");
+	if (P->name) printf("%5s %8s %s\n", "", "", P->name);
+	if (P->error) printf("%5s %8s error : %s\n", "", "", P->error);
+}
+
+static int listPlugins(pluginLister list, const char* text) {
+	if (!list) {
+		logError("This liblualadspa has no plugin database!");
+		return -1;
+	}
+	printf("%5s %8s %-24s %5s %s\n", "INDEX", "ID", "LABEL", "PORTS", "FILE");
+	list(printPlugin, const_cast<char*>(text));
+	return 0;
+}
 
 #if defined(_WIN32) || defined(WIN32) 
 #define WIN32_LEAN_AND_MEAN
@@ -95,7 +430,9 @@ float getDefault(LADSPA_PortRangeHint desc) {
 #define LIBNAME "liblualadspa.so"
 #endif
 
-int main() {
+int main(int argc, char** argv) {
+	if (argc > 1 && std::strcmp(argv[1], "top") == 0)
+		return runTop(argc > 2 && std::strcmp(argv[2], "--once") == 0);
 
 	auto handle = OPENLIB(LIBNAME);
 	if (!handle) handle = OPENLIB("./" LIBNAME);
@@ -117,17 +454,55 @@ int main() {
 	}
 
 	FILE* old = setLog(stderr);
-	if (old != stderr) fclose(old);
+	if (old != stderr && old != stdout) fclose(old);
+
+	if (argc > 1 && std::strcmp(argv[1], "alloccheck") == 0) {
+		int blocks = argc > 2 ? atoi(argv[2]) : 1000;
+		int res = allocCheck(ladspa_descriptor, reinterpret_cast<memoryStatsGetter>(
+			SYMLIB(handle, "lualadspa_memory_stats")), reinterpret_cast<errorsGetter>(
+			SYMLIB(handle, "lualadspa_errors")), blocks > 0 ? blocks : 1000);
+		CLOSELIB(handle);
+		return res;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "list") == 0) {
+		int res = listPlugins(reinterpret_cast<pluginLister>(
+			SYMLIB(handle, "lualadspa_plugins")), argc > 2 ? argv[2] : nullptr);
+		CLOSELIB(handle);
+		return res;
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "bench") == 0) {
+		const char* label = argc > 2 && std::strcmp(argv[2], "all") ? argv[2] : nullptr;
+		int blocks = argc > 3 ? atoi(argv[3]) : 2000;
+		int res = bench(ladspa_descriptor, reinterpret_cast<flushSetter>(
+			SYMLIB(handle, "lualadspa_set_flush_denormals")), label,
+			blocks > 0 ? blocks : 2000);
+		CLOSELIB(handle);
+		return res;
+	}
+
+	auto saveState = reinterpret_cast<stateSaver>(
+		SYMLIB(handle, "lualadspa_save_state"));
+	auto loadState = reinterpret_cast<stateLoader>(
+		SYMLIB(handle, "lualadspa_load_state"));
+	auto freeState = reinterpret_cast<stateFree>(
+		SYMLIB(handle, "lualadspa_free_state"));
 
 	int ind = 0;
 	const LADSPA_Descriptor* D;
 	LADSPA_Data tmp[128];
 
 	while ((D = ladspa_descriptor(ind)) != nullptr) {
+		if (isPlaceholder(D)) {
+			logInfo("Slot %i : plugin %s is not available", ind++, D->Label);
+			logInfo("----------------------------------------------");
+			continue;
+		}
 		logInfo("Checking plugin %s...", D->Label);
 		auto inst = D->instantiate(D, 65535);
-		logInfo("name %s, label %s, portsCount %i, index %i", D->Name, D->Label,
-				D->PortCount, ind);
+		logInfo("name %s, label %s, id %lu, portsCount %i, index %i", D->Name,
+				D->Label, D->UniqueID, D->PortCount, ind);
 
 		if (inst != nullptr) {
 			D->activate(inst);
@@ -166,6 +541,15 @@ int main() {
 			D->run(inst, 128);
 			D->deactivate(inst);
 			logInfo("Deactivation...");
+			if (saveState && loadState && freeState) {
+				size_t size = 0;
+				void* state = saveState(inst, &size);
+				if (state) {
+					logInfo("State : %zu bytes, %s", size, loadState(inst, state, size) ?
+						"loaded back" : "CAN'T LOAD IT BACK");
+					freeState(state);
+				} else logInfo("State can't be saved");
+			}
 			D->cleanup(inst);	
 		} else logError("Can't instantiate plugin %s!", D->Name);
 		ind++;
@@ -0,0 +1,327 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Database of plugin files, to not load unchanged plugins again
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "fileIO.hpp"
+#include <chrono>
+#include <cstring>
+
+/*
+ * Each plugin file has a record : stamps (mtime and size) of the file and
+ * of all files it loads (chain stages, graph nodes, modules), hash of the
+ * source, and properties needed for the descriptor, bytecode or the
+ * error of the last load. On library load files are only stat()ed, and
+ * changed ones are loaded again, so descriptors are made without lua.
+ *
+ * File is binary : header line, then records of varints and strings
+ * (varint length + bytes). Version in the header must be changed with the
+ * record format or with the properties parser (internal.lua), then the
+ * database is built from scratch. Bytecode has a checksum, and it's
+ * compiled again if it's damaged or made by other luau version.
+ */
+static const char db_header[] = "lualadspa db 2\n";
+
+// 64 bit FNV-1a
+static uint64_t hashSource(const std::string& s) {
+	uint64_t h = 14695981039346656037ull;
+	for (unsigned char c : s) {
+		h ^= c;
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+bool ReplaceFile(const std::string& file, const std::string& data) {
+	std::error_code ec;
+	const fsys::path path(file);
+	fsys::create_directories(path.parent_path(), ec);
+	// other hosts may read it right now : write a copy, and replace
+	auto tmp = path;
+	tmp += strformat(".%llx", (unsigned long long)
+		std::chrono::steady_clock::now().time_since_epoch().count());
+	{
+		FileIO f;
+		if (!f.open(tmp, "wb") || !f.write(data)) {
+			f.close();
+			fsys::remove(tmp, ec);
+			return false;
+		}
+	}
+	fsys::rename(tmp, path, ec);
+	if (ec) fsys::remove(tmp, ec);
+	return !ec;
+}
+
+/*
+ * Tracing of LoadPlugin() : files and error
+ */
+
+struct LoadTrace {
+	std::vector<std::string> files;
+	uint64_t hash = 0;
+	std::string error;
+};
+static thread_local LoadTrace* trace = nullptr;
+
+void TraceFile(const char* file, const std::string* source) {
+	if (!trace) return;
+	if (trace->files.empty() && source) trace->hash = hashSource(*source);
+	for (auto& f : trace->files) if (f == file) return;
+	trace->files.push_back(file);
+}
+
+void TraceError(const std::string& error) {
+	if (trace) trace->error = error; // outer one is the last
+}
+
+static bool stampFile(const std::string& file, FileStamp& S) {
+	std::error_code ec;
+	const fsys::path path(file);
+	S.file = file;
+	S.size = fsys::file_size(path, ec);
+	if (ec) return false;
+	auto time = fsys::last_write_time(path, ec);
+	if (ec) return false;
+	S.mtime = time.time_since_epoch().count();
+	return true;
+}
+
+uint64_t BytecodeChecksum(const std::string& bytecode) {
+	return hashSource(bytecode);
+}
+
+PluginRecord ScanPlugin(const std::string& file, PlugPropShared& props) {
+	LoadTrace T;
+	trace = &T;
+	props = LoadPlugin(file.c_str());
+	trace = nullptr;
+
+	PluginRecord R;
+	R.hash = T.hash;
+	if (T.files.empty() || T.files[0] != file) T.files.insert(T.files.begin(), file);
+	for (auto& f : T.files) {
+		FileStamp S;
+		if (!stampFile(f, S)) {
+			if (R.files.empty()) break; // no plugin file, can't be fresh ever
+			S.mtime = 0;
+			S.size = FileStamp::missing;
+		}
+		R.files.push_back(S);
+	}
+	if (!props) {
+		R.error = T.error.empty() ? "can't load plugin" : T.error;
+		return R;
+	}
+	auto str = [] (const char* s) { return std::string(s ? s : ""); };
+	R.label = str(props->label);
+	R.name = str(props->name);
+	R.maker = str(props->maker);
+	R.copyright = str(props->copyright);
+	R.id = props->id;
+	R.realtime = props->realtime;
+	for (size_t i = 0; i < props->portCount; i++) {
+		R.portNames.push_back(str(props->portNames[i]));
+		R.portDescriptors.push_back(props->portDescriptors[i]);
+		R.portRangeHints.push_back(props->portRangeHints[i]);
+	}
+	R.bytecode = props->bytecode;
+	R.checksum = BytecodeChecksum(*R.bytecode);
+	return R;
+}
+
+bool IsRecordFresh(PluginRecord& R, bool& touched) {
+	if (R.files.empty()) return false;
+	// checked before the first luau_load() of it
+	if (R.error.empty() && BytecodeChecksum(*R.bytecode) != R.checksum) {
+		logError("Cached bytecode of plugin %s is damaged!", R.files[0].file.c_str());
+		return false;
+	}
+	for (size_t i = 0; i < R.files.size(); i++) {
+		FileStamp& old = R.files[i];
+		FileStamp now;
+		const bool exists = stampFile(old.file, now);
+		if (old.size == FileStamp::missing) {
+			if (exists) return false; // new stage, module or shadowing module
+			continue;
+		}
+		if (!exists) return false;
+		if (now.mtime == old.mtime && now.size == old.size) continue;
+		// plugin file itself may be just touched (copied, checked out...)
+		std::string source;
+		if (i || now.size != old.size || !loadFileContent(old.file.c_str(), source) ||
+				hashSource(source) != R.hash) return false;
+		old = now;
+		touched = true;
+	}
+	return true;
+}
+
+/*
+ * Serialization
+ */
+
+static void putVarint(std::string& out, uint64_t v) {
+	while (v >= 0x80) {
+		out += char(v | 0x80);
+		v >>= 7;
+	}
+	out += char(v);
+}
+
+static void putString(std::string& out, const std::string& s) {
+	putVarint(out, s.size());
+	out += s;
+}
+
+template <typename T>
+static void putRaw(std::string& out, const T& v) {
+	out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+class DatabaseReader {
+	const std::string& in;
+	size_t pos;
+	public:
+	bool ok = true;
+
+	DatabaseReader(const std::string& in, size_t pos) : in(in), pos(pos) {}
+	bool done() const {return !ok || pos >= in.size();}
+	size_t left() const {return in.size() - pos;}
+
+	uint64_t varint() {
+		uint64_t v = 0;
+		for (int shift = 0; shift < 64 && pos < in.size(); shift += 7) {
+			uint8_t b = in[pos++];
+			v |= (uint64_t)(b & 0x7F) << shift;
+			if (!(b & 0x80)) return v;
+		}
+		ok = false;
+		return 0;
+	}
+	std::string string() {
+		uint64_t len = varint();
+		if (len > in.size() - pos) ok = false;
+		if (!ok) return "";
+		pos += len;
+		return in.substr(pos - len, len);
+	}
+	template <typename T>
+	T raw() {
+		T v{};
+		if (pos + sizeof(T) > in.size()) ok = false;
+		if (!ok) return v;
+		std::memcpy(&v, in.data() + pos, sizeof(T));
+		pos += sizeof(T);
+		return v;
+	}
+};
+
+PluginDatabase ReadDatabase(const std::string& file) {
+	PluginDatabase db;
+	std::error_code ec;
+	if (!fsys::exists(file, ec)) return db;
+	std::string data;
+	FileIO f;
+	if (!f.open(file, "rb")) return db;
+	f.seek(0, FileIO::SeekBase::END);
+	auto len = f.tell();
+	f.rewind();
+	if (len < 0 || !f.read(data, len)) return db;
+	const size_t header = sizeof(db_header) - 1;
+	if (data.compare(0, header, db_header) != 0) {
+		logInfo("Plugin database %s is old, rebuilding it", file.c_str());
+		return db;
+	}
+	DatabaseReader in(data, header);
+	while (!in.done()) {
+		std::string name = in.string();
+		PluginRecord R;
+		uint64_t files = in.varint();
+		if (files > in.left()) in.ok = false; // at least byte per file
+		if (in.ok) R.files.resize(files);
+		for (auto& S : R.files) {
+			if (!in.ok) break;
+			S.file = in.string();
+			S.mtime = in.raw<int64_t>();
+			S.size = in.varint();
+		}
+		R.hash = in.raw<uint64_t>();
+		R.error = in.string();
+		if (R.error.empty()) {
+			R.label = in.string();
+			R.name = in.string();
+			R.maker = in.string();
+			R.copyright = in.string();
+			R.id = in.varint();
+			R.realtime = in.varint();
+			size_t ports = in.varint();
+			for (size_t i = 0; i < ports && in.ok; i++) {
+				R.portNames.push_back(in.string());
+				R.portDescriptors.push_back(in.varint());
+				LADSPA_PortRangeHint H;
+				H.HintDescriptor = in.varint();
+				H.LowerBound = in.raw<LADSPA_Data>();
+				H.UpperBound = in.raw<LADSPA_Data>();
+				R.portRangeHints.push_back(H);
+			}
+			R.bytecode = std::make_shared<const std::string>(in.string());
+			R.checksum = in.raw<uint64_t>();
+		}
+		if (in.ok) db[name] = std::move(R);
+	}
+	if (!in.ok) {
+		logError("Bad plugin database %s, ignored!", file.c_str());
+		db.clear();
+	}
+	return db;
+}
+
+void WriteDatabase(const std::string& file, const PluginDatabase& db) {
+	std::string out = db_header;
+	for (auto& [name, R] : db) {
+		putString(out, name);
+		putVarint(out, R.files.size());
+		for (auto& S : R.files) {
+			putString(out, S.file);
+			putRaw(out, S.mtime);
+			putVarint(out, S.size);
+		}
+		putRaw(out, R.hash);
+		putString(out, R.error);
+		if (!R.error.empty()) continue;
+		putString(out, R.label);
+		putString(out, R.name);
+		putString(out, R.maker);
+		putString(out, R.copyright);
+		putVarint(out, R.id);
+		putVarint(out, R.realtime);
+		putVarint(out, R.portNames.size());
+		for (size_t i = 0; i < R.portNames.size(); i++) {
+			putString(out, R.portNames[i]);
+			putVarint(out, R.portDescriptors[i]);
+			putVarint(out, R.portRangeHints[i].HintDescriptor);
+			putRaw(out, R.portRangeHints[i].LowerBound);
+			putRaw(out, R.portRangeHints[i].UpperBound);
+		}
+		putString(out, R.bytecode ? *R.bytecode : std::string());
+		putRaw(out, R.checksum);
+	}
+	if (!ReplaceFile(file, out))
+		logError("Can't write plugin database %s!", file.c_str());
+}
@@ -0,0 +1,366 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Native dynamics building blocks : envelope followers, gain computer,
+ * lookahead limiter and block statistics.
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#define ENVNAME "_envelopeMT"
+#define GAINNAME "_gaincomputerMT"
+#define LIMNAME "_limiterMT"
+
+// one pole smoothing coefficient for time in milliseconds
+static float timeCoef(double ms, double rate) {
+	if (ms <= 0.0) return 0.0f;
+	return (float)std::exp(-1.0 / (ms * 0.001 * rate));
+}
+
+// size argument, checked against all given buffers
+static size_t checkSize(lua_State* L, int idx, LadspaBuffer* a, LadspaBuffer* b) {
+	size_t sz = luaL_optinteger(L, idx, b ? std::min(a->size, b->size) : a->size);
+	if (!a->buffer || sz > a->size || (b && (!b->buffer || sz > b->size)))
+		luaL_error(L, "size is out of buffer bounds");
+	return sz;
+}
+
+/*
+ * Envelope follower. Peak mode follows absolute value, RMS mode follows
+ * squared signal. Recursive by nature, so it is processed sample by sample.
+ */
+
+struct Envelope {
+	double rate;
+	float attack, release; // coefficients
+	float value; // current state (squared in rms mode)
+	bool rms;
+};
+
+static const char* const env_modes[] = {"peak", "rms", nullptr};
+
+static Envelope* checkEnv(lua_State* L) {
+	return reinterpret_cast<Envelope*>(luaL_checkudata(L, 1, ENVNAME));
+}
+
+static void envSet(lua_State* L, Envelope* E, int idx) {
+	E->attack  = timeCoef(luaL_checknumber(L, idx), E->rate);
+	E->release = timeCoef(luaL_checknumber(L, idx+1), E->rate);
+}
+
+// ladspa.newEnvelope(attack, release, [mode])
+static int lenv_new(lua_State* L) {
+	lua_settop(L, 3);
+	Envelope* E = reinterpret_cast<Envelope*>(
+		lua_newuserdata(L, sizeof(Envelope)));
+	E->rate = GetSampleRate(L);
+	E->value = 0.0f;
+	E->rms = luaL_checkoption(L, 3, "peak", env_modes) == 1;
+	envSet(L, E, 1);
+	luaL_getmetatable(L, ENVNAME);
+	lua_setmetatable(L, -2);
+	return 1;
+}
+
+// env:process(input, output, [size]) -> last envelope value
+static int lenv_process(lua_State* L) {
+	Envelope* E = checkEnv(L);
+	LadspaBuffer* in  = CheckBuffer(L, 2);
+	LadspaBuffer* out = CheckOutBuffer(L, 3);
+	size_t sz = checkSize(L, 4, in, out);
+	const sample_type* src = in->buffer;
+	sample_type* dst = out->buffer;
+	const float a = E->attack, r = E->release;
+	float e = E->value;
+	if (E->rms) {
+		for (size_t i = 0; i < sz; i++) {
+			const float x = src[i] * src[i];
+			const float c = x > e ? a : r;
+			e = x + c * (e - x);
+			dst[i] = std::sqrt(e);
+		}
+	} else {
+		for (size_t i = 0; i < sz; i++) {
+			const float x = std::fabs(src[i]);
+			const float c = x > e ? a : r;
+			e = x + c * (e - x);
+			dst[i] = e;
+		}
+	}
+	E->value = e;
+	lua_pushnumber(L, E->rms ? std::sqrt(e) : e);
+	return 1;
+}
+
+static int lenv_set(lua_State* L) {
+	envSet(L, checkEnv(L), 2);
+	return 0;
+}
+
+static int lenv_value(lua_State* L) {
+	Envelope* E = checkEnv(L);
+	lua_pushnumber(L, E->rms ? std::sqrt(E->value) : E->value);
+	return 1;
+}
+
+static int lenv_reset(lua_State* L) {
+	checkEnv(L)->value = 0.0f;
+	return 0;
+}
+
+static const luaL_Reg env_methods[] = {
+	{"process", lenv_process},
+	{"set", lenv_set},
+	{"value", lenv_value},
+	{"reset", lenv_reset},
+	{nullptr, nullptr}
+};
+
+/*
+ * Gain computer : converts envelope (linear) into gain factor (linear)
+ * using threshold (dB), ratio and soft knee width (dB).
+ */
+
+struct GainComputer {
+	float threshold, ratio, knee;
+};
+
+static GainComputer* checkGain(lua_State* L) {
+	return reinterpret_cast<GainComputer*>(luaL_checkudata(L, 1, GAINNAME));
+}
+
+static void gainSet(lua_State* L, GainComputer* G, int idx) {
+	G->threshold = luaL_checknumber(L, idx);
+	G->ratio = luaL_checknumber(L, idx+1);
+	G->knee = luaL_optnumber(L, idx+2, 0.0);
+	if (G->ratio < 1.0f) luaL_error(L, "ratio must be >= 1");
+	if (G->knee < 0.0f) luaL_error(L, "knee must be >= 0");
+}
+
+// ladspa.newGainComputer(threshold, ratio, [knee])
+static int lgain_new(lua_State* L) {
+	lua_settop(L, 3);
+	GainComputer* G = reinterpret_cast<GainComputer*>(
+		lua_newuserdata(L, sizeof(GainComputer)));
+	gainSet(L, G, 1);
+	luaL_getmetatable(L, GAINNAME);
+	lua_setmetatable(L, -2);
+	return 1;
+}
+
+// gain:process(envelope, gain, [size]) -> minimal gain in the block
+static int lgain_process(lua_State* L) {
+	GainComputer* G = checkGain(L);
+	LadspaBuffer* in  = CheckBuffer(L, 2);
+	LadspaBuffer* out = CheckOutBuffer(L, 3);
+	size_t sz = checkSize(L, 4, in, out);
+	const sample_type* src = in->buffer;
+	sample_type* dst = out->buffer;
+	const float T = G->threshold, W = G->knee;
+	const float slope = 1.0f / G->ratio - 1.0f;
+	float mingain = 1.0f;
+	for (size_t i = 0; i < sz; i++) {
+		const float x = 20.0f * std::log10(std::fabs(src[i]) + 1e-30f);
+		const float over = x - T;
+		float g; // gain reduction in dB
+		if (2.0f * over < -W) g = 0.0f;
+		else if (W > 0.0f && 2.0f * std::fabs(over) <= W) { // hard knee if 0
+			const float k = over + W * 0.5f;
+			g = slope * k * k / (2.0f * W);
+		} else g = slope * over;
+		dst[i] = std::pow(10.0f, g * 0.05f);
+		mingain = std::min(mingain, dst[i]);
+	}
+	lua_pushnumber(L, mingain);
+	return 1;
+}
+
+static int lgain_set(lua_State* L) {
+	gainSet(L, checkGain(L), 2);
+	return 0;
+}
+
+static const luaL_Reg gain_methods[] = {
+	{"process", lgain_process},
+	{"set", lgain_set},
+	{nullptr, nullptr}
+};
+
+/*
+ * Lookahead peak limiter. Signal is delayed by lookahead, and required gain
+ * is the minimum over the lookahead window (sliding minimum with monotonic
+ * queue), so gain is already reduced when the peak comes out.
+ */
+
+struct Limiter {
+	size_t delay;   // lookahead in samples
+	size_t pos;     // write position in the delay line
+	size_t head, tail; // monotonic queue (indices into qval/qidx)
+	size_t counter; // absolute sample index
+	float ceiling;
+	float attack, release;
+	float gain;
+	float* line; // delay
+	float* qval; // delay + 2 (see below)
+	size_t* qidx;
+};
+
+/*
+ * Window holds delay + 1 samples (old ones are dropped before the new
+ * one is pushed), and ring needs one more entry : full ring would have
+ * head == tail, and look empty.
+ */
+static size_t limQueueSize(size_t delay) {
+	return delay + 2;
+}
+
+static Limiter* checkLim(lua_State* L) {
+	return reinterpret_cast<Limiter*>(luaL_checkudata(L, 1, LIMNAME));
+}
+
+static void limReset(Limiter* M) {
+	std::memset(M->line, 0, M->delay * sizeof(float));
+	M->pos = M->head = M->tail = M->counter = 0;
+	M->gain = 1.0f;
+}
+
+// ladspa.newLimiter(lookahead, ceiling, release)
+static int llim_new(lua_State* L) {
+	double rate = GetSampleRate(L);
+	double ahead = luaL_checknumber(L, 1);
+	float ceiling = luaL_optnumber(L, 2, 1.0);
+	double release = luaL_optnumber(L, 3, 50.0);
+	size_t delay = std::max((size_t)1, (size_t)(ahead * 0.001 * rate));
+	if (ceiling <= 0.0f) luaL_error(L, "ceiling must be positive");
+	size_t qsz = limQueueSize(delay);
+	size_t sz = sizeof(Limiter) + delay * sizeof(float) + qsz * sizeof(float) +
+		qsz * sizeof(size_t);
+	Limiter* M = reinterpret_cast<Limiter*>(lua_newuserdata(L, sz));
+	M->delay = delay;
+	M->ceiling = ceiling;
+	// gain must reach the target during lookahead time
+	M->attack = timeCoef(ahead / 5.0, rate);
+	M->release = timeCoef(release, rate);
+	M->qidx = reinterpret_cast<size_t*>(M + 1);
+	M->qval = reinterpret_cast<float*>(M->qidx + qsz);
+	M->line = M->qval + qsz;
+	limReset(M);
+	luaL_getmetatable(L, LIMNAME);
+	lua_setmetatable(L, -2);
+	return 1;
+}
+
+// lim:process(input, output, [size]) -> minimal gain in the block
+static int llim_process(lua_State* L) {
+	Limiter* M = checkLim(L);
+	LadspaBuffer* in  = CheckBuffer(L, 2);
+	LadspaBuffer* out = CheckOutBuffer(L, 3);
+	size_t sz = checkSize(L, 4, in, out);
+	const sample_type* src = in->buffer;
+	sample_type* dst = out->buffer;
+	const size_t qsz = limQueueSize(M->delay);
+	float g = M->gain, mingain = 1.0f;
+	for (size_t i = 0; i < sz; i++) {
+		const float x = src[i];
+		const float a = std::fabs(x);
+		const float need = a > M->ceiling ? M->ceiling / a : 1.0f;
+		// drop samples that left the window, push into sliding minimum
+		while (M->head != M->tail && M->qidx[M->head] + M->delay < M->counter)
+			M->head = (M->head + 1) % qsz;
+		while (M->head != M->tail) {
+			size_t last = (M->tail + qsz - 1) % qsz;
+			if (M->qval[last] < need) break;
+			M->tail = last;
+		}
+		M->qval[M->tail] = need;
+		M->qidx[M->tail] = M->counter;
+		M->tail = (M->tail + 1) % qsz;
+		const float target = M->qval[M->head];
+
+		const float c = target < g ? M->attack : M->release;
+		g = target + c * (g - target);
+		if (g < mingain) mingain = g;
+
+		float y = M->line[M->pos] * g;
+		M->line[M->pos] = x;
+		M->pos = (M->pos + 1) % M->delay;
+		M->counter++;
+		// smoothing is not perfect, so be safe
+		if (y > M->ceiling) y = M->ceiling;
+		else if (y < -M->ceiling) y = -M->ceiling;
+		dst[i] = y;
+	}
+	M->gain = g;
+	lua_pushnumber(L, mingain);
+	return 1;
+}
+
+static int llim_latency(lua_State* L) {
+	lua_pushinteger(L, checkLim(L)->delay);
+	return 1;
+}
+
+static int llim_reset(lua_State* L) {
+	limReset(checkLim(L));
+	return 0;
+}
+
+static const luaL_Reg lim_methods[] = {
+	{"process", llim_process},
+	{"latency", llim_latency},
+	{"reset", llim_reset},
+	{nullptr, nullptr}
+};
+
+/*
+ * ladspa.blockStats(buffer, [size]) -> peak, rms, mean
+ * Plain reductions without dependencies, so compiler vectorizes them.
+ */
+static int lstats(lua_State* L) {
+	LadspaBuffer* B = CheckBuffer(L, 1);
+	size_t sz = checkSize(L, 2, B, nullptr);
+	const sample_type* __restrict src = B->buffer;
+	float peak = 0.0f, sum = 0.0f, sq = 0.0f;
+	for (size_t i = 0; i < sz; i++) {
+		peak = std::max(peak, std::fabs(src[i]));
+		sum += src[i];
+		sq  += src[i] * src[i];
+	}
+	float n = sz ? (float)sz : 1.0f;
+	lua_pushnumber(L, peak);
+	lua_pushnumber(L, std::sqrt(sq / n));
+	lua_pushnumber(L, sum / n);
+	return 3;
+}
+
+static const luaL_Reg dyn_funcs[] = {
+	{"newEnvelope", lenv_new},
+	{"newGainComputer", lgain_new},
+	{"newLimiter", llim_new},
+	{"blockStats", lstats},
+	{nullptr, nullptr}
+};
+
+void OpenLuaDynamics(lua_State* L) {
+	NewClass(L, ENVNAME, env_methods);
+	NewClass(L, GAINNAME, gain_methods);
+	NewClass(L, LIMNAME, lim_methods);
+	luaL_register(L, "ladspa", dyn_funcs);
+	lua_pop(L, 1);
+}
@@ -0,0 +1,470 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Native FFT and uniformly partitioned convolution for lua plugins
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include <cmath>
+#include <cstring>
+#include <cstdint>
+#include <new>
+
+#define FFTNAME  "_fftMT"
+#define CONVNAME "_convolverMT"
+
+constexpr size_t fft_min_size = 4;
+constexpr size_t fft_max_size = 1 << 20;
+
+static bool isPowerOfTwo(size_t n) {
+	return n && !(n & (n - 1));
+}
+
+/*
+ * Twiddles and bit reversal permutation for one FFT size.
+ * They are immutable after creation, so they are shared between all
+ * states and threads. Complex FFT of size n/2 (used by real FFT of size n)
+ * reuses the same table with stride 2.
+ */
+struct FFTTables {
+	size_t n;
+	std::unique_ptr<float[]> cosv; //  cos(2*pi*k/n), k in [0, n/2)
+	std::unique_ptr<float[]> sinv; // -sin(2*pi*k/n)
+	std::unique_ptr<uint32_t[]> rev;
+
+	FFTTables(size_t size) : n(size) {
+		cosv = std::make_unique<float[]>(n/2);
+		sinv = std::make_unique<float[]>(n/2);
+		rev  = std::make_unique<uint32_t[]>(n);
+		for (size_t k = 0; k < n/2; k++) {
+			double a = 2.0 * M_PI * (double)k / (double)n;
+			cosv[k] = (float)std::cos(a);
+			sinv[k] = (float)-std::sin(a);
+		}
+		int bits = 0;
+		while (((size_t)1 << bits) < n) bits++;
+		for (size_t i = 0; i < n; i++) {
+			uint32_t r = 0;
+			for (int b = 0; b < bits; b++) if (i & ((size_t)1 << b)) r |= 1u << (bits - 1 - b);
+			rev[i] = r;
+		}
+	}
+};
+
+using FFTTablesShared = std::shared_ptr<const FFTTables>;
+
+static FFTTablesShared getTables(size_t n) {
+	static std::mutex lock;
+	static std::map<size_t, FFTTablesShared> cache;
+	std::lock_guard<std::mutex> guard(lock);
+	auto it = cache.find(n);
+	if (it != cache.end()) return it->second;
+	auto T = std::make_shared<const FFTTables>(n);
+	cache.emplace(n, T);
+	return T;
+}
+
+/*
+ * In-place radix-2 complex FFT of size T.n/stride.
+ * Forward transform is not scaled, inverse one is NOT scaled too
+ * (callers do this, since real transforms need different factor).
+ */
+static void fftComplex(const FFTTables& T, float* re, float* im,
+		size_t stride, bool inverse) {
+	const size_t m = T.n / stride;
+	for (size_t i = 0; i < m; i++) {
+		size_t j = T.rev[i * stride];
+		if (i < j) {
+			std::swap(re[i], re[j]);
+			std::swap(im[i], im[j]);
+		}
+	}
+	const float sign = inverse ? -1.0f : 1.0f;
+	for (size_t len = 2; len <= m; len <<= 1) {
+		const size_t half = len >> 1;
+		const size_t step = (T.n / len);
+		for (size_t i = 0; i < m; i += len) {
+			float* ar = re + i; float* ai = im + i;
+			float* br = ar + half; float* bi = ai + half;
+			for (size_t k = 0; k < half; k++) {
+				const float wr = T.cosv[k * step];
+				const float wi = T.sinv[k * step] * sign;
+				const float tr = br[k] * wr - bi[k] * wi;
+				const float ti = br[k] * wi + bi[k] * wr;
+				br[k] = ar[k] - tr;
+				bi[k] = ai[k] - ti;
+				ar[k] += tr;
+				ai[k] += ti;
+			}
+		}
+	}
+}
+
+/*
+ * Real FFT of size T.n through complex FFT of size T.n/2.
+ * Writes n/2+1 bins. zre and zim are scratch arrays of n/2 elements.
+ */
+static void fftRealForward(const FFTTables& T, const float* in,
+		float* re, float* im, float* zre, float* zim) {
+	const size_t m = T.n / 2;
+	for (size_t k = 0; k < m; k++) {
+		zre[k] = in[2*k];
+		zim[k] = in[2*k+1];
+	}
+	fftComplex(T, zre, zim, 2, false);
+	re[0] = zre[0] + zim[0]; im[0] = 0;
+	re[m] = zre[0] - zim[0]; im[m] = 0;
+	for (size_t k = 1; k < m; k++) {
+		const float ar = zre[k],   ai = zim[k];
+		const float br = zre[m-k], bi = -zim[m-k];
+		const float er = (ar + br) * 0.5f, ei = (ai + bi) * 0.5f;
+		const float orr = (ai - bi) * 0.5f, oi = (br - ar) * 0.5f;
+		const float wr = T.cosv[k], wi = T.sinv[k];
+		re[k] = er + wr * orr - wi * oi;
+		im[k] = ei + wr * oi + wi * orr;
+	}
+}
+
+/*
+ * Inverse of the function above (normalized, so roundtrip is identity).
+ */
+static void fftRealInverse(const FFTTables& T, const float* re,
+		const float* im, float* out, float* zre, float* zim) {
+	const size_t m = T.n / 2;
+	for (size_t k = 0; k < m; k++) {
+		const float ar = re[k],   ai = im[k];
+		const float br = re[m-k], bi = -im[m-k];
+		const float er = (ar + br) * 0.5f, ei = (ai + bi) * 0.5f;
+		const float dr = (ar - br) * 0.5f, di = (ai - bi) * 0.5f;
+		const float wr = T.cosv[k], wi = -T.sinv[k]; // conj
+		const float orr = dr * wr - di * wi, oi = dr * wi + di * wr;
+		zre[k] = er - oi;
+		zim[k] = ei + orr;
+	}
+	fftComplex(T, zre, zim, 2, true);
+	const float scale = 1.0f / (float)m;
+	for (size_t k = 0; k < m; k++) {
+		out[2*k]   = zre[k] * scale;
+		out[2*k+1] = zim[k] * scale;
+	}
+}
+
+static LadspaBuffer* checkSized(lua_State* L, int idx, size_t need,
+		bool output = false) {
+	LadspaBuffer* B = output ? CheckOutBuffer(L, idx) : CheckBuffer(L, idx);
+	if (!B->buffer || B->size < need)
+		luaL_error(L, "buffer #%i is too small (%i < %i)", idx,
+			(int)B->size, (int)need);
+	return B;
+}
+
+/*
+ * FFT object
+ */
+
+struct FFTObject {
+	FFTTablesShared T;
+	size_t n;
+	float* zre; // scratch
+	float* zim;
+};
+
+static void fftdtor(void* p) {
+	reinterpret_cast<FFTObject*>(p)->~FFTObject();
+}
+
+static FFTObject* checkFFT(lua_State* L) {
+	return reinterpret_cast<FFTObject*>(luaL_checkudata(L, 1, FFTNAME));
+}
+
+static int lfft_new(lua_State* L) {
+	size_t n = luaL_checkinteger(L, 1);
+	if (!isPowerOfTwo(n) || n < fft_min_size || n > fft_max_size)
+		luaL_error(L, "FFT size must be power of two in range [%i, %i]",
+			(int)fft_min_size, (int)fft_max_size);
+	FFTTablesShared T = getTables(n);
+	void* ud = lua_newuserdatadtor(L, sizeof(FFTObject) + n * sizeof(float),
+		fftdtor);
+	FFTObject* F = new (ud) FFTObject{T, n, nullptr, nullptr};
+	F->zre = reinterpret_cast<float*>(F + 1);
+	F->zim = F->zre + n/2;
+	luaL_getmetatable(L, FFTNAME);
+	lua_setmetatable(L, -2);
+	return 1;
+}
+
+static int lfft_size(lua_State* L) {
+	lua_pushinteger(L, checkFFT(L)->n);
+	return 1;
+}
+
+static int lfft_complex(lua_State* L, bool inverse) {
+	FFTObject* F = checkFFT(L);
+	LadspaBuffer* re = checkSized(L, 2, F->n, true);
+	LadspaBuffer* im = checkSized(L, 3, F->n, true);
+	fftComplex(*F->T, re->buffer, im->buffer, 1, inverse);
+	if (inverse) {
+		const float scale = 1.0f / (float)F->n;
+		for (size_t i = 0; i < F->n; i++) {
+			re->buffer[i] *= scale;
+			im->buffer[i] *= scale;
+		}
+	}
+	return 0;
+}
+
+static int lfft_forward(lua_State* L) {
+	return lfft_complex(L, false);
+}
+
+static int lfft_inverse(lua_State* L) {
+	return lfft_complex(L, true);
+}
+
+static int lfft_forwardReal(lua_State* L) {
+	FFTObject* F = checkFFT(L);
+	LadspaBuffer* in = checkSized(L, 2, F->n);
+	LadspaBuffer* re = checkSized(L, 3, F->n/2 + 1, true);
+	LadspaBuffer* im = checkSized(L, 4, F->n/2 + 1, true);
+	fftRealForward(*F->T, in->buffer, re->buffer, im->buffer, F->zre, F->zim);
+	return 0;
+}
+
+static int lfft_inverseReal(lua_State* L) {
+	FFTObject* F = checkFFT(L);
+	LadspaBuffer* re = checkSized(L, 2, F->n/2 + 1);
+	LadspaBuffer* im = checkSized(L, 3, F->n/2 + 1);
+	LadspaBuffer* out = checkSized(L, 4, F->n, true);
+	fftRealInverse(*F->T, re->buffer, im->buffer, out->buffer, F->zre, F->zim);
+	return 0;
+}
+
+static const luaL_Reg fft_methods[] = {
+	{"size", lfft_size},
+	{"forward", lfft_forward},
+	{"inverse", lfft_inverse},
+	{"forwardReal", lfft_forwardReal},
+	{"inverseReal", lfft_inverseReal},
+	{nullptr, nullptr}
+};
+
+/*
+ * Uniformly partitioned convolution (overlap-save with frequency domain
+ * delay line). Impulse response is split into partitions of `block`
+ * samples, each one is transformed with real FFT of size 2*block.
+ */
+struct ConvKernel {
+	size_t block;
+	size_t parts;
+	FFTTablesShared T;
+	std::unique_ptr<float[]> re; // parts * (block+1)
+	std::unique_ptr<float[]> im;
+};
+
+using ConvKernelShared = std::shared_ptr<const ConvKernel>;
+
+static ConvKernelShared makeKernel(const sample_type* ir, size_t len,
+		size_t block) {
+	auto K = std::make_shared<ConvKernel>();
+	const size_t bins = block + 1;
+	K->block = block;
+	K->parts = len ? (len + block - 1) / block : 1;
+	K->T = getTables(block * 2);
+	K->re = std::make_unique<float[]>(K->parts * bins);
+	K->im = std::make_unique<float[]>(K->parts * bins);
+
+	auto frame = std::make_unique<float[]>(block * 4); // + scratch
+	float* zre = frame.get() + block * 2;
+	float* zim = zre + block;
+	for (size_t p = 0; p < K->parts; p++) {
+		std::memset(frame.get(), 0, block * 2 * sizeof(float));
+		size_t off = p * block;
+		size_t n = len > off ? std::min(block, len - off) : 0;
+		for (size_t i = 0; i < n; i++) frame[i] = ir[off + i];
+		fftRealForward(*K->T, frame.get(), K->re.get() + p * bins,
+			K->im.get() + p * bins, zre, zim);
+	}
+	return K;
+}
+
+struct Convolver {
+	ConvKernelShared K;
+	size_t pos; // position in the current block
+	size_t cur; // current frequency delay line slot
+	float* input;  // 2 * block sliding window
+	float* output; // block of ready samples
+	float* time;   // 2 * block
+	float* fdlre;  // parts * (block+1)
+	float* fdlim;
+	float* accre;  // block+1
+	float* accim;
+	float* zre;    // block (fft scratch)
+	float* zim;
+};
+
+static size_t convFloats(const ConvKernel& K) {
+	const size_t bins = K.block + 1;
+	return K.block * 7 + K.parts * bins * 2 + bins * 2;
+}
+
+static void convReset(Convolver* C) {
+	std::memset(C->input, 0, convFloats(*C->K) * sizeof(float));
+	C->pos = 0;
+	C->cur = 0;
+}
+
+static void convBlock(Convolver* C) {
+	const ConvKernel& K = *C->K;
+	const size_t B = K.block, bins = B + 1;
+	float* xre = C->fdlre + C->cur * bins;
+	float* xim = C->fdlim + C->cur * bins;
+	fftRealForward(*K.T, C->input, xre, xim, C->zre, C->zim);
+
+	float* __restrict accre = C->accre;
+	float* __restrict accim = C->accim;
+	std::memset(accre, 0, bins * sizeof(float));
+	std::memset(accim, 0, bins * sizeof(float));
+	for (size_t p = 0; p < K.parts; p++) {
+		size_t slot = (C->cur + K.parts - p) % K.parts;
+		const float* __restrict ar = C->fdlre + slot * bins;
+		const float* __restrict ai = C->fdlim + slot * bins;
+		const float* __restrict hr = K.re.get() + p * bins;
+		const float* __restrict hi = K.im.get() + p * bins;
+		for (size_t k = 0; k < bins; k++) {
+			accre[k] += ar[k] * hr[k] - ai[k] * hi[k];
+			accim[k] += ar[k] * hi[k] + ai[k] * hr[k];
+		}
+	}
+
+	fftRealInverse(*K.T, accre, accim, C->time, C->zre, C->zim);
+	std::memcpy(C->output, C->time + B, B * sizeof(float));
+	std::memmove(C->input, C->input + B, B * sizeof(float));
+	C->cur = (C->cur + 1) % K.parts;
+}
+
+static void convdtor(void* p) {
+	reinterpret_cast<Convolver*>(p)->~Convolver();
+}
+
+static Convolver* checkConv(lua_State* L) {
+	return reinterpret_cast<Convolver*>(luaL_checkudata(L, 1, CONVNAME));
+}
+
+/*
+ * ladspa.newConvolver(ir, block, [name])
+ * ir may be a buffer or function, that returns it. If name is given,
+ * prepared kernel is cached for the plugin type, and ir is used only
+ * by the first instance.
+ */
+static int lconv_new(lua_State* L) {
+	size_t block = luaL_checkinteger(L, 2);
+	const char* name = luaL_optstring(L, 3, nullptr);
+	if (!isPowerOfTwo(block) || block < fft_min_size/2 ||
+			block > fft_max_size/2)
+		luaL_error(L, "convolver block size must be power of two in range "
+			"[%i, %i]", (int)fft_min_size/2, (int)fft_max_size/2);
+
+	std::string key;
+	if (name) key = strformat("conv:%s:%i", name, (int)block);
+	ConvKernelShared K = SharedResource<ConvKernel>(GetProperties(L), key,
+		[L, block] () {
+			lua_pushvalue(L, 1);
+			if (lua_isfunction(L, -1)) lua_call(L, 0, 1);
+			LadspaBuffer* ir = CheckBuffer(L, -1);
+			auto K = makeKernel(ir->buffer, ir->buffer ? ir->size : 0, block);
+			lua_pop(L, 1);
+			return K;
+		});
+
+	void* ud = lua_newuserdatadtor(L, sizeof(Convolver) +
+		convFloats(*K) * sizeof(float), convdtor);
+	Convolver* C = new (ud) Convolver{};
+	C->K = K;
+	const size_t bins = block + 1;
+	C->input  = reinterpret_cast<float*>(C + 1);
+	C->output = C->input  + block * 2;
+	C->time   = C->output + block;
+	C->fdlre  = C->time   + block * 2;
+	C->fdlim  = C->fdlre  + K->parts * bins;
+	C->accre  = C->fdlim  + K->parts * bins;
+	C->accim  = C->accre  + bins;
+	C->zre    = C->accim  + bins;
+	C->zim    = C->zre    + block;
+	convReset(C);
+	luaL_getmetatable(L, CONVNAME);
+	lua_setmetatable(L, -2);
+	return 1;
+}
+
+// convolver:process(input, output, [size])
+static int lconv_process(lua_State* L) {
+	Convolver* C = checkConv(L);
+	LadspaBuffer* in  = CheckBuffer(L, 2);
+	LadspaBuffer* out = CheckOutBuffer(L, 3);
+	size_t sz = luaL_optinteger(L, 4, std::min(in->size, out->size));
+	if (sz > in->size || sz > out->size || !in->buffer || !out->buffer)
+		luaL_error(L, "size is out of buffer bounds");
+
+	const size_t B = C->K->block;
+	const sample_type* src = in->buffer;
+	sample_type* dst = out->buffer;
+	while (sz) {
+		size_t n = std::min(B - C->pos, sz);
+		float* win = C->input + B + C->pos;
+		float* ready = C->output + C->pos;
+		for (size_t i = 0; i < n; i++) { // may be inplace
+			win[i] = src[i];
+			dst[i] = ready[i];
+		}
+		C->pos += n; src += n; dst += n; sz -= n;
+		if (C->pos == B) {
+			convBlock(C);
+			C->pos = 0;
+		}
+	}
+	return 0;
+}
+
+static int lconv_reset(lua_State* L) {
+	convReset(checkConv(L));
+	return 0;
+}
+
+// in samples
+static int lconv_latency(lua_State* L) {
+	lua_pushinteger(L, checkConv(L)->K->block);
+	return 1;
+}
+
+static const luaL_Reg conv_methods[] = {
+	{"process", lconv_process},
+	{"reset", lconv_reset},
+	{"latency", lconv_latency},
+	{nullptr, nullptr}
+};
+
+static const luaL_Reg fft_funcs[] = {
+	{"newFFT", lfft_new},
+	{"newConvolver", lconv_new},
+	{nullptr, nullptr}
+};
+
+void OpenLuaFFT(lua_State* L) {
+	NewClass(L, FFTNAME, fft_methods);
+	NewClass(L, CONVNAME, conv_methods);
+	luaL_register(L, "ladspa", fft_funcs);
+	lua_pop(L, 1);
+}
@@ -0,0 +1,606 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Graph plugins : DAG of plugin instances, running on a thread pool
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "fileIO.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <semaphore.h>
+#endif
+
+/*
+ * Graph manifest is a plugin file with `graph` table instead of ports
+ * and callbacks : nodes (other plugin files) and connections between
+ * their audio ports. Unlike chain, each node is a separate instance with
+ * it's own lua state, so nodes which don't depend on each other run in
+ * parallel : in each block, node becomes ready when all nodes it reads
+ * from are done, and ready nodes are taken by pool threads and host
+ * thread from one shared queue. Host thread joins before writing outputs.
+ *
+ * Audio thread never takes a mutex : pool threads sleep on semaphore,
+ * posted for each ready node, and host thread sleeps on another one,
+ * posted by the pool thread which finished the last node, so it waits
+ * only as long as nodes run. Pool threads get scheduling class of the
+ * host thread, so they are not preempted by less important threads
+ * while host waits for them.
+ */
+constexpr int graph_max_threads = 64;
+constexpr int graph_max_ports = 64; // audio inputs/outputs of the graph
+// nodes run() at most this number of samples at once, bigger host blocks
+// are processed in parts (buffers are allocated by instantiate())
+constexpr size_t graph_block = 1024;
+constexpr int graph_spin = 64; // tries to take not ready node before sleep
+
+// post() is one atomic operation, and syscall only if somebody sleeps
+class Semaphore {
+	public:
+#ifdef _WIN32
+	HANDLE sem;
+	Semaphore() {sem = CreateSemaphore(nullptr, 0, LONG_MAX, nullptr);}
+	~Semaphore() {CloseHandle(sem);}
+	void post() {ReleaseSemaphore(sem, 1, nullptr);}
+	void wait() {WaitForSingleObject(sem, INFINITE);}
+#else
+	sem_t sem;
+	Semaphore() {sem_init(&sem, 0, 0);}
+	~Semaphore() {sem_destroy(&sem);}
+	void post() {sem_post(&sem);}
+	void wait() {while (sem_wait(&sem) != 0 && errno == EINTR) {}}
+#endif
+};
+
+class GraphState {
+	public:
+	const GraphLayout* G;
+	std::vector<PluginHandle*> nodes; // in topological order, owned
+	std::vector<sample_type> storage; // internal buffers, then zeros
+	std::unique_ptr<sample_type[]> dummy; // latency ports of the nodes
+	std::vector<size_t> latency; // of paths to each node
+
+	/*
+	 * Scheduler state of the current block. Head and ready slots are
+	 * tagged by block number in high bits, so thread late from previous
+	 * block can't take stale node instead of one of this block.
+	 */
+	std::unique_ptr<std::atomic<int>[]> pending; // nodes to wait for
+	std::unique_ptr<std::atomic<uint64_t>[]> ready; // queue of nodes
+	std::atomic<uint64_t> head{0}; // (block << 32) | next queue index
+	std::atomic<size_t> tail{0};
+	std::atomic<size_t> done{0};
+	uint64_t block = 0; // host thread only
+	unsigned long samples = 0;
+
+	Semaphore wake; // for pool threads, posted for ready nodes
+	Semaphore finished; // for host thread, if it hasn't run the last node
+	std::atomic<bool> stop{false};
+	std::vector<std::thread> threads;
+
+	// scheduling class of the host thread, pool threads take it on wake up
+	std::atomic<int> policy{0}, priority{0};
+	std::atomic<unsigned> schedule{0}; // changes when they are set
+	bool scheduled = false; // since activate(), host thread only
+
+	void loop();
+	bool work(bool host); // true if the last node was run by this thread
+	bool runNode(size_t i, uint64_t tag, bool host);
+	void push(size_t i, uint64_t tag) {
+		const size_t t = tail.fetch_add(1, std::memory_order_relaxed);
+		ready[t].store((tag << 32) | i, std::memory_order_release);
+	}
+	sample_type* buffer(int b) {
+		return storage.data() + b * graph_block;
+	}
+	sample_type* zeros() {
+		return buffer(G->bufferNode.size());
+	}
+	void stopThreads();
+};
+
+void GraphState::stopThreads() {
+	if (threads.empty()) return;
+	stop = true;
+	for (size_t i = 0; i < threads.size(); i++) wake.post();
+	for (auto& t : threads) t.join();
+	threads.clear();
+}
+
+void GraphStateDeleter::operator()(GraphState* S) const {
+	S->stopThreads();
+	for (PluginHandle* N : S->nodes) {
+		UnregisterInstance(N);
+		delete N;
+	}
+	delete S;
+}
+
+/*
+ * Master state part
+ */
+
+struct Endpoint {
+	int node = -2; // -1 is the graph itself, -2 is not connected
+	int port = 0;
+};
+
+// "node:port" (port index from 1 or port name), "in:k" or "out:k"
+static Endpoint parseEndpoint(lua_State* L, const char* str, bool source,
+		const std::vector<std::string>& names,
+		const std::vector<PlugPropShared>& nodes, size_t ins, size_t outs) {
+	const std::string s = str;
+	const size_t colon = s.find(':');
+	if (colon == std::string::npos)
+		luaL_error(L, "bad graph endpoint %s (\"node:port\" excepted)!", str);
+	const std::string name = s.substr(0, colon), port = s.substr(colon + 1);
+	Endpoint E;
+	if (name == (source ? "in" : "out")) {
+		E.node = -1;
+		E.port = atoi(port.c_str()) - 1;
+		if (E.port < 0 || E.port >= (int)(source ? ins : outs))
+			luaL_error(L, "no graph port %s!", str);
+		return E;
+	}
+	auto it = std::find(names.begin(), names.end(), name);
+	if (it == names.end()) luaL_error(L, "no graph node %s!", str);
+	E.node = it - names.begin();
+	const PluginProperties* P = nodes[E.node].get();
+	char* end = nullptr;
+	E.port = strtol(port.c_str(), &end, 10) - 1;
+	if (port.empty() || *end) { // by name
+		E.port = -1;
+		for (size_t i = 0; i < P->portCount; i++)
+			if (port == P->portNames[i]) E.port = i;
+	}
+	if (E.port < 0 || E.port >= (int)P->portCount)
+		luaL_error(L, "no node port %s!", str);
+	const auto desc = P->portDescriptors[E.port];
+	if (!IS_AUDIO(desc) || (source ? !IS_OUTPUT(desc) : !IS_INPUT(desc)))
+		luaL_error(L, "%s must be audio %s!", str, source ? "output" : "input");
+	return E;
+}
+
+static size_t countField(lua_State* L, const char* field, int max) {
+	lua_getfield(L, 1, field);
+	const double v = luaL_optnumber(L, -1, 0);
+	if (v < 0 || v > max || (int)v != v)
+		luaL_error(L, "graph.%s must be integer in range 0..%i!", field, max);
+	lua_pop(L, 1);
+	return (size_t)v;
+}
+
+static void pushGraphPort(lua_State* L, const char* type, const char* name) {
+	lua_createtable(L, 0, 2);
+	lua_pushstring(L, type);
+	lua_setfield(L, -2, "type");
+	lua_pushstring(L, name);
+	lua_setfield(L, -2, "name");
+	lua_rawseti(L, 2, lua_objlen(L, 2) + 1);
+}
+
+// (props, manifest file name) : loads nodes, sets ports global
+static int lgraph_load(lua_State* L) {
+	PluginProperties* P = reinterpret_cast<PluginProperties*>
+		(lua_tolightuserdata(L, 1));
+	const fsys::path dir = fsys::path(lua_tostring(L, 2)).parent_path();
+	lua_settop(L, 0);
+	if (lua_getfield(L, LUA_GLOBALSINDEX, "graph") != LUA_TTABLE)
+		luaL_error(L, "graph must be a table!");
+	if (lua_getfield(L, LUA_GLOBALSINDEX, "ports") != LUA_TNIL)
+		luaL_error(L, "graph plugin can't have it's own ports!");
+	if (lua_getfield(L, LUA_GLOBALSINDEX, "info") == LUA_TTABLE) {
+		lua_getfield(L, -1, "oversample");
+		lua_getfield(L, -2, "async");
+		lua_getfield(L, -3, "worker");
+		if (lua_tonumber(L, -3) > 1 || lua_toboolean(L, -2) || lua_toboolean(L, -1))
+			luaL_error(L, "graph plugin can't use oversample, async and worker "
+				"(but it's nodes can)!");
+	}
+	lua_settop(L, 1);
+
+	auto G = std::make_unique<GraphLayout>();
+	G->inputs = countField(L, "inputs", graph_max_ports);
+	const size_t outs = countField(L, "outputs", graph_max_ports);
+	const int hw = std::thread::hardware_concurrency();
+	lua_getfield(L, 1, "threads");
+	const bool threads = !lua_isnil(L, -1);
+	lua_pop(L, 1);
+	G->threads = threads ? countField(L, "threads", graph_max_threads) : -1;
+
+	// {name = "node", file = "file.lua"}
+	std::vector<std::string> names;
+	std::vector<PlugPropShared> nodes;
+	if (lua_getfield(L, 1, "nodes") != LUA_TTABLE)
+		luaL_error(L, "graph.nodes must be an array of nodes!");
+	const int n = lua_objlen(L, 2);
+	if (n < 1) luaL_error(L, "graph has no nodes!");
+	for (int i = 1; i <= n; i++) {
+		lua_rawgeti(L, 2, i);
+		if (!lua_istable(L, -1)) luaL_error(L, "bad graph node %i!", i);
+		lua_getfield(L, -1, "name");
+		lua_getfield(L, -2, "file");
+		if (!lua_isstring(L, -2) || !lua_isstring(L, -1))
+			luaL_error(L, "graph node %i must have name and file!", i);
+		const std::string name = lua_tostring(L, -2), file = lua_tostring(L, -1);
+		lua_settop(L, 2);
+		if (name == "in" || name == "out" || name.find(':') != std::string::npos
+				|| std::find(names.begin(), names.end(), name) != names.end())
+			luaL_error(L, "bad or duplicate graph node name %s!", name.c_str());
+		PlugPropShared S = LoadPlugin((dir / file).string().c_str());
+		if (!S) luaL_error(L, "can't load graph node %s!", file.c_str());
+		if (S->graph) luaL_error(L, "graph node %s is a graph too!", file.c_str());
+		names.push_back(name);
+		nodes.push_back(S);
+	}
+	lua_settop(L, 1);
+
+	// {"from", "to"} : source of each audio input
+	std::vector<std::vector<Endpoint>> sources(n);
+	for (int i = 0; i < n; i++) sources[i].resize(nodes[i]->portCount);
+	std::vector<Endpoint> outSources(outs);
+	if (lua_getfield(L, 1, "connect") == LUA_TTABLE) {
+		for (int i = 1; i <= (int)lua_objlen(L, 2); i++) {
+			lua_rawgeti(L, 2, i);
+			lua_rawgeti(L, -1, 1);
+			lua_rawgeti(L, -2, 2);
+			if (!lua_isstring(L, -2) || !lua_isstring(L, -1))
+				luaL_error(L, "graph connection %i must be {\"from\", \"to\"}!", i);
+			const Endpoint from = parseEndpoint(L, lua_tostring(L, -2), true,
+				names, nodes, G->inputs, outs);
+			const Endpoint to = parseEndpoint(L, lua_tostring(L, -1), false,
+				names, nodes, G->inputs, outs);
+			Endpoint& dst = to.node < 0 ? outSources[to.port] :
+				sources[to.node][to.port];
+			if (dst.node != -2)
+				luaL_error(L, "%s is connected twice!", lua_tostring(L, -1));
+			dst = from;
+			lua_pop(L, 3);
+		}
+	}
+	lua_settop(L, 1);
+
+	// topological order (manifest order if possible)
+	std::vector<std::vector<int>> users(n);
+	std::vector<int> deps(n, 0);
+	for (int i = 0; i < n; i++) {
+		std::vector<bool> seen(n, false);
+		for (const Endpoint& E : sources[i]) if (E.node >= 0 && !seen[E.node]) {
+			seen[E.node] = true;
+			users[E.node].push_back(i);
+			deps[i]++;
+		}
+	}
+	std::vector<int> order, left = deps;
+	for (int i = 0; i < n; i++) if (!deps[i]) order.push_back(i);
+	for (size_t k = 0; k < order.size(); k++)
+		for (int u : users[order[k]]) if (--left[u] == 0) order.push_back(u);
+	if ((int)order.size() < n) luaL_error(L, "graph has a cycle!");
+	std::vector<int> position(n);
+	for (int k = 0; k < n; k++) position[order[k]] = k;
+
+	// internal buffer for each audio output of each node
+	std::vector<std::vector<int>> buffers(n);
+	for (int k = 0; k < n; k++) {
+		const PluginProperties* S = nodes[order[k]].get();
+		buffers[order[k]].assign(S->portCount, -1);
+		for (size_t p = 0; p < S->portCount; p++) {
+			const auto desc = S->portDescriptors[p];
+			if (!IS_AUDIO(desc) || !IS_OUTPUT(desc)) continue;
+			buffers[order[k]][p] = G->bufferNode.size();
+			G->bufferNode.push_back(k);
+		}
+	}
+	auto sourceCode = [&] (const Endpoint& E) {
+		if (E.node == -2) return graph_internal;
+		if (E.node == -1) return E.port; // graph input
+		return -buffers[E.node][E.port] - 2;
+	};
+
+	// ports of the graph : audio inputs, outputs, then control ports of
+	// the nodes (in manifest order) and summed latency
+	lua_newtable(L); // 2
+	for (size_t k = 1; k <= G->inputs; k++)
+		pushGraphPort(L, "ia", strformat("Input %i", (int)k).c_str());
+	for (size_t k = 1; k <= outs; k++)
+		pushGraphPort(L, "oa", strformat("Output %i", (int)k).c_str());
+	std::vector<std::vector<int>> ports(n);
+	bool latency = false;
+	for (int i = 0; i < n; i++) {
+		const PluginProperties* S = nodes[i].get();
+		latency = latency || S->latencyPort >= 0 || S->oversample > 1 || S->async;
+		for (size_t p = 0; p < S->portCount; p++) {
+			const auto desc = S->portDescriptors[p];
+			int code;
+			if ((int)p == S->latencyPort) code = graph_internal;
+			else if (IS_CONTROL(desc)) {
+				code = lua_objlen(L, 2);
+				PushPortDescription(L, S, p, names[i].c_str());
+				lua_rawseti(L, 2, code + 1);
+			} else if (IS_OUTPUT(desc)) code = -buffers[i][p] - 2;
+			else code = sourceCode(sources[i][p]);
+			ports[i].push_back(code);
+		}
+	}
+	if (latency) pushGraphPort(L, "oc", "latency");
+
+	for (int k = 0; k < n; k++) {
+		GraphNode N;
+		N.props = nodes[order[k]];
+		N.ports = ports[order[k]];
+		for (int u : users[order[k]]) N.next.push_back(position[u]);
+		N.inputs = deps[order[k]];
+		G->nodes.push_back(std::move(N));
+	}
+	for (const Endpoint& E : outSources) // buffer, graph input -(k + 2) or -1
+		G->outputs.push_back(E.node == -2 ? -1 : E.node == -1 ? -E.port - 2 :
+			buffers[E.node][E.port]);
+	if (G->threads < 0) G->threads = std::max(0, std::min(n, hw) - 1);
+	P->graph = std::move(G);
+	lua_setfield(L, LUA_GLOBALSINDEX, "ports"); // parsed as usual after
+	return 0;
+}
+
+bool LoadGraph(LuaState& L, PluginProperties* props, const char* name) {
+	lua_pushcfunction(L, lgraph_load, "loadGraph");
+	lua_pushlightuserdata(L, props);
+	lua_pushstring(L, name);
+	return lua_pcall(L, 2, 0, 0) == LUA_OK;
+}
+
+/*
+ * Instance part
+ */
+
+bool LoadGraphInstance(PluginHandle* H) {
+	const GraphLayout* G = H->P->graph.get();
+	H->graph.reset(new GraphState);
+	GraphState* S = H->graph.get();
+	S->G = G;
+	H->connected = std::make_unique<sample_type*[]>(H->P->portCount);
+	for (const GraphNode& node : G->nodes) {
+		PluginHandle* N = makeHandle(node.props, H->samplerate);
+		if (!N) {
+			lua_pushfstring(H->L, "can't instantiate graph node %s",
+				node.props->label);
+			return false;
+		}
+		S->nodes.push_back(N);
+	}
+	const size_t n = G->nodes.size();
+	S->dummy = std::make_unique<sample_type[]>(n);
+	S->latency.resize(n);
+	S->pending = std::make_unique<std::atomic<int>[]>(n);
+	S->ready = std::make_unique<std::atomic<uint64_t>[]>(n); // block 0 tag
+	S->storage.assign((G->bufferNode.size() + 1) * graph_block, 0.0f);
+	return true;
+}
+
+size_t GraphNodeCount(const PluginHandle* H) {
+	return H->graph ? H->graph->nodes.size() : 0;
+}
+
+PluginHandle* GetGraphNode(PluginHandle* H, size_t i) {
+	return H->graph->nodes[i];
+}
+
+void StartGraph(PluginHandle* H) {
+	GraphState* S = H->graph.get();
+	S->stopThreads();
+	S->stop = false;
+	S->scheduled = false;
+	for (int i = 0; i < S->G->threads; i++)
+		S->threads.emplace_back(&GraphState::loop, S);
+}
+
+void StopGraph(PluginHandle* H) {
+	H->graph->stopThreads();
+}
+
+// gets scheduling class of the calling (host) thread
+static void getSchedule(int& policy, int& priority) {
+#ifdef _WIN32
+	policy = 0;
+	priority = GetThreadPriority(GetCurrentThread());
+#else
+	sched_param param{};
+	if (pthread_getschedparam(pthread_self(), &policy, &param) != 0)
+		policy = SCHED_OTHER;
+	priority = param.sched_priority;
+#endif
+}
+
+static bool setSchedule(int policy, int priority) {
+#ifdef _WIN32
+	(void)policy;
+	return SetThreadPriority(GetCurrentThread(), priority);
+#else
+	sched_param param{};
+	param.sched_priority = priority;
+	return pthread_setschedparam(pthread_self(), policy, &param) == 0;
+#endif
+}
+
+void GraphState::loop() {
+	unsigned seen = 0;
+	while (true) {
+		wake.wait();
+		if (stop) return;
+		const unsigned s = schedule.load(std::memory_order_acquire);
+		if (s != seen) {
+			seen = s;
+			if (!setSchedule(policy, priority))
+				logError("Can't give graph thread scheduling class of the host!");
+		}
+		work(false);
+	}
+}
+
+/*
+ * Takes ready nodes until all nodes of the block are taken, or until
+ * the next one is not ready for a while : thread which makes it ready
+ * takes it itself, and wakes others if it makes more nodes ready.
+ */
+bool GraphState::work(bool host) {
+	const size_t n = nodes.size();
+	bool last = false;
+	for (int spin = 0; spin < graph_spin; ) {
+		uint64_t h = head.load(std::memory_order_acquire);
+		const uint64_t tag = h >> 32;
+		const size_t idx = h & 0xFFFFFFFF;
+		if (idx >= n) break;
+		const uint64_t slot = ready[idx].load(std::memory_order_acquire);
+		if (slot >> 32 != tag) { // node is not ready yet
+			spin++;
+			std::this_thread::yield();
+			continue;
+		}
+		if (!head.compare_exchange_weak(h, h + 1, std::memory_order_acq_rel))
+			continue;
+		if (runNode(slot & 0xFFFFFFFF, tag, host)) last = true;
+		spin = 0;
+	}
+	return last;
+}
+
+bool GraphState::runNode(size_t i, uint64_t tag, bool host) {
+	PluginHandle* N = nodes[i];
+	const GraphNode& node = G->nodes[i];
+	if (!N->shutdown) {
+		if (N->async) RunAsync(N, samples);
+		else ProcessBlock(N, N->connected.get(), samples);
+	}
+	if (N->shutdown) for (int code : node.ports) // silence, not garbage
+		if (code < graph_internal && G->bufferNode[-code - 2] == (int)i)
+			std::memset(buffer(-code - 2), 0, samples * sizeof(sample_type));
+	bool first = true; // this thread takes it itself
+	for (int next : node.next)
+		if (pending[next].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			push(next, tag);
+			if (!first && !threads.empty()) wake.post();
+			first = false;
+		}
+	const bool last = done.fetch_add(1, std::memory_order_acq_rel) + 1 ==
+		nodes.size();
+	if (last && !host) finished.post();
+	return last;
+}
+
+// points node ports to host data (from offset) and internal buffers
+static void connectNodes(PluginHandle* H, unsigned long offset,
+		unsigned long n) {
+	GraphState* S = H->graph.get();
+	const GraphLayout* G = S->G;
+	std::memset(S->zeros(), 0, n * sizeof(sample_type));
+	for (size_t i = 0; i < S->nodes.size(); i++) {
+		PluginHandle* N = S->nodes[i];
+		const auto& ports = G->nodes[i].ports;
+		const auto* desc = N->P->portDescriptors.get();
+		for (size_t p = 0; p < ports.size(); p++) {
+			const int code = ports[p];
+			if (code >= 0) {
+				sample_type* data = H->connected[code];
+				N->connected[p] = data && IS_AUDIO(desc[p]) ? data + offset : data;
+			} else if (code == graph_internal)
+				N->connected[p] = IS_AUDIO(desc[p]) ? S->zeros() : &S->dummy[i];
+			else N->connected[p] = S->buffer(-code - 2);
+		}
+	}
+}
+
+// latency of the longest path to outputs
+static size_t graphLatency(PluginHandle* H) {
+	GraphState* S = H->graph.get();
+	const GraphLayout* G = S->G;
+	std::fill(S->latency.begin(), S->latency.end(), 0);
+	for (size_t i = 0; i < S->nodes.size(); i++) {
+		S->latency[i] += PluginLatency(S->nodes[i]);
+		for (int next : G->nodes[i].next)
+			S->latency[next] = std::max(S->latency[next], S->latency[i]);
+	}
+	size_t latency = 0;
+	for (int b : G->outputs) if (b >= 0)
+		latency = std::max(latency, S->latency[G->bufferNode[b]]);
+	return latency;
+}
+
+// runs all nodes for the part of the host block
+static void runPart(PluginHandle* H, unsigned long offset, unsigned long n) {
+	GraphState* S = H->graph.get();
+	const GraphLayout* G = S->G;
+	connectNodes(H, offset, n);
+
+	S->block++;
+	S->samples = n;
+	S->tail.store(0, std::memory_order_relaxed);
+	S->done.store(0, std::memory_order_relaxed);
+	size_t ready = 0;
+	for (size_t i = 0; i < S->nodes.size(); i++) {
+		S->pending[i].store(G->nodes[i].inputs, std::memory_order_relaxed);
+		if (!G->nodes[i].inputs) {
+			S->push(i, S->block);
+			ready++;
+		}
+	}
+	S->head.store(S->block << 32, std::memory_order_release);
+	// host thread takes one of them itself
+	for (size_t k = 1; k < ready && k <= S->threads.size(); k++) S->wake.post();
+	if (!S->work(true)) S->finished.wait();
+
+	// outputs are written after all nodes, host may process in place
+	for (size_t k = 0; k < G->outputs.size(); k++) {
+		sample_type* out = H->connected[G->inputs + k];
+		const int b = G->outputs[k];
+		const sample_type* from = b >= 0 ? S->buffer(b) :
+			b == -1 ? S->zeros() : H->connected[-b - 2];
+		if (b < -1 && from) from += offset;
+		if (out) out += offset;
+		if (out && from) std::memmove(out, from, n * sizeof(sample_type));
+	}
+}
+
+void RunGraph(PluginHandle* H, unsigned long samplecount) {
+	GraphState* S = H->graph.get();
+	const auto start = std::chrono::steady_clock::now();
+	if (!S->scheduled && !S->threads.empty()) { // once per activation
+		int policy, priority;
+		getSchedule(policy, priority);
+		S->policy = policy;
+		S->priority = priority;
+		S->schedule.fetch_add(1, std::memory_order_release);
+		S->scheduled = true;
+	}
+	for (unsigned long done = 0; done < samplecount; done += graph_block)
+		runPart(H, done, std::min<unsigned long>(graph_block,
+			samplecount - done));
+
+	H->latency = graphLatency(H);
+	const int lp = H->P->latencyPort;
+	if (lp >= 0 && H->connected[lp]) *H->connected[lp] = (sample_type)H->latency;
+	PublishTelemetry(H, samplecount, std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count());
+}
@@ -18,6 +18,7 @@
  */
 
 #include "lualadspa.hpp"
+#include <cstring>
 
 static void ProxyGlobals(lua_State* L) {
 	lua_createtable(L, 0, 1);
@@ -59,8 +60,7 @@ void InitMasterState(LuaState& L) {
 
 #include "internal.h"
 bool InitMasterValues(LuaState& L, PluginProperties* props) {
-	lua_pushlightuserdata(L, props);
-	lua_setfield(L, LUA_REGISTRYINDEX, "props");
+	SetProperties(L, props);
 	lua_setreadonly(L, LUA_GLOBALSINDEX, false);
 	// load internal bytecode
 	if (!L.loadBytecode(internal_bcode, internal_size, "=internal")) return false;
@@ -77,18 +77,47 @@ bool InitInstanceBuffers(lua_State* L, PluginHandle* H) {
 	lua_setfield(L, LUA_GLOBALSINDEX, "buffers");
 	lua_pushvalue(L, -1);
 	lua_setfield(L, LUA_REGISTRYINDEX, "buffers");
+	H->ports = std::make_unique<LadspaBuffer*[]>(H->P->portCount);
+	H->connected = std::make_unique<sample_type*[]>(H->P->portCount);
 	for (int i = 1; i <= H->P->portCount; i++) {
-		if (!NewBuffer(L, true)) return false;
+		LadspaBuffer* B = NewBuffer(L, true);
+		if (!B) return false;
+		H->ports[i-1] = B; // anchored by the table below
+		H->connected[i-1] = nullptr;
 		lua_rawseti(L, -2, i);
 	}
 	lua_setreadonly(L, -1, true);
 	lua_pop(L, 1);
-	// add samplerate here
-	lua_pushnumber(L, H->samplerate);
-	lua_setfield(L, LUA_REGISTRYINDEX, "samplerate");
 	return true;
 }
 
+PluginProperties* GetProperties(lua_State* L) {
+	lua_getfield(L, LUA_REGISTRYINDEX, "props");
+	void* p = lua_tolightuserdata(L, -1);
+	lua_pop(L, 1);
+	return reinterpret_cast<PluginProperties*>(p);
+}
+
+double GetSampleRate(lua_State* L) {
+	double rate = 48000.0; // master state has no samplerate
+	lua_getfield(L, LUA_REGISTRYINDEX, "samplerate");
+	if (lua_isnumber(L, -1)) rate = lua_tonumber(L, -1);
+	lua_pop(L, 1);
+	return rate;
+}
+
+PluginHandle* GetHandle(lua_State* L) {
+	lua_getfield(L, LUA_REGISTRYINDEX, "handle");
+	void* p = lua_tolightuserdata(L, -1);
+	lua_pop(L, 1);
+	return reinterpret_cast<PluginHandle*>(p);
+}
+
+void SetProperties(lua_State* L, PluginProperties* props) {
+	lua_pushlightuserdata(L, props);
+	lua_setfield(L, LUA_REGISTRYINDEX, "props");
+}
+
 /*
  * Loads ladspa library + applies sandbox
  */
@@ -112,12 +141,13 @@ void LuaState::limitMemoryKB(size_t KBytes) {
 	allocdata.maxlimit = KBytes << 10; // cast to KiloBytes
 }
 
-bool LuaState::loadBytecode(const char* b, size_t sz, const char* name) {
-	return luau_load(L, name, b, sz, 0) == LUA_OK;
+bool LuaState::loadBytecode(const char* b, size_t sz, const char* name,
+		int env) {
+	return luau_load(L, name, b, sz, env) == LUA_OK;
 }
 	
-bool LuaState::loadBytecode(const std::string &bc, const char* name) {
-	return luau_load(L, name, bc.c_str(), bc.size(), 0) == LUA_OK;
+bool LuaState::loadBytecode(const std::string &bc, const char* name, int env) {
+	return luau_load(L, name, bc.c_str(), bc.size(), env) == LUA_OK;
 }
 
 void LuaState::compileCode(const char* s, size_t l, std::string& b) {
@@ -129,39 +159,72 @@ void LuaState::compileCode(const char* s, size_t l, std::string& b) {
 
 #include <malloc.h>
 void* LuaState::limalloc(void* p, size_t old, size_t nsz) {
-	size_t add = 0;
-	if (nsz) {
-		if (!p) {
-			add = nsz;
-			if (allocdata.allocated + nsz <= allocdata.maxlimit) p = malloc(nsz);
-		} else if (old < nsz) {
-			add = nsz - old;
-			if (allocdata.allocated + nsz <= allocdata.maxlimit)
-				p = realloc(p, nsz);
-			else p = nullptr; // keep old block
-		} else {
-			add = old - nsz;
-			void* o = p;
-			p = realloc(p, nsz);
-			if (!p) p = o; // no throw on shrinking
-			allocdata.allocated -= add; // here not add, but sub <3
-			return p;
+	LimitedAllocData& A = allocdata;
+	if (!nsz) {
+		if (p) {
+			free(p);
+			A.allocated -= old;
+			A.frees++;
 		}
-		// do nothing if equal
-	} else if (p) {
-		add = old;
-		free(p); p = nullptr;
-		allocdata.allocated -= add; // here not add, but sub <3
 		return nullptr;
 	}
-	allocdata.allocated += add;
-	return p;
+	if (p && old >= nsz) { // no throw on shrinking
+		void* o = p;
+		p = realloc(p, nsz);
+		if (!p) p = o;
+		A.allocated -= old - nsz;
+		return p;
+	}
+	const size_t add = p ? nsz - old : nsz;
+	void* n = nullptr;
+	if (UNLIKELY(A.inRun && A.strict)) { // allocation in steady state run()
+		A.strictViolations++;
+		A.lastViolation = add;
+		A.pending = true;
+		if (A.strict == STRICT_FAIL) {
+			A.denied = true;
+			return nullptr;
+		}
+	}
+	if (A.allocated + add <= A.maxlimit) n = p ? realloc(p, nsz) : malloc(nsz);
+	if (!n) { // old block is kept
+		A.failed++;
+		return nullptr;
+	}
+	A.allocated += add;
+	A.bytes += add;
+	A.allocations++;
+	if (nsz > A.largest) A.largest = nsz;
+	if (A.allocated > A.peak) A.peak = A.allocated;
+	if (A.inRun) {
+		A.runAllocations++;
+		A.runBytes += add;
+	}
+	return n;
 }
 
 /*
  * INTERNALS
  */
 
+const char* StringArena::add(const char* s, size_t len) {
+	const size_t block = 4096;
+	if (used + len + 1 > size) { // big strings get their own block
+		size = len + 1 > block ? len + 1 : block;
+		blocks.push_back(std::make_unique<char[]>(size));
+		used = 0;
+	}
+	char* dst = blocks.back().get() + used;
+	std::memcpy(dst, s, len);
+	dst[len] = '\0';
+	used += len + 1;
+	return dst;
+}
+
+const char* StringArena::add(const char* s) {
+	return s ? add(s, std::strlen(s)) : nullptr;
+}
+
 static int setup_arrays(PluginProperties* props, int n) {
 	props->portNames = std::make_unique<const char*[]>(n);
 	props->portDescriptors = std::make_unique<LADSPA_PortDescriptor[]>(n);
@@ -180,11 +243,22 @@ static int luaI_setvalue(lua_State* L) {
 	if (name.empty()) {
 		luaL_error(L, "internal field name excepted!");
 	}
-	EQ(name, lua_tostring(L, -1))
-	EQ(label, lua_tostring(L, -1))
-	EQ(maker, lua_tostring(L, -1))
-	EQ(copyright, lua_tostring(L, -1))
+	EQ(name, prop->strings.add(lua_tostring(L, -1)))
+	EQ(label, prop->strings.add(lua_tostring(L, -1)))
+	EQ(maker, prop->strings.add(lua_tostring(L, -1)))
+	EQ(copyright, prop->strings.add(lua_tostring(L, -1)))
+	EQ(id, (unsigned long)lua_tonumber(L, -1))
 	EQ(realtime, lua_toboolean(L, -1))
+	EQ(oversample, lua_tointeger(L, -1))
+	EQ(worker, lua_toboolean(L, -1))
+	EQ(async, lua_tointeger(L, -1))
+	EQ(strict, lua_tointeger(L, -1))
+	EQ(warmup, lua_tointeger(L, -1))
+	EQ(poolSize, lua_tointeger(L, -1))
+	EQ(snapshot, lua_toboolean(L, -1))
+	EQ(flushDenormals, lua_toboolean(L, -1))
+	EQ(latencyPort, lua_tointeger(L, -1) - 1)
+	EQ(channels, lua_tointeger(L, -1); prop->channelPorts.resize(prop->channels))
 	EQ(portCount, lua_tointeger(L, -1); setup_arrays(prop, lua_tointeger(L, -1)))
 	#undef TOK
 	#undef EQ
@@ -203,7 +277,7 @@ static int luaI_setport(lua_State* L) {
 	int hint = luaL_checkinteger(L, 5);
 	float min = luaL_optnumber(L, 6, -1.0);
 	float max = luaL_optnumber(L, 7,  1.0);
-	prop->portNames.get()[index] = name;
+	prop->portNames.get()[index] = prop->strings.add(name);
 	prop->portDescriptors.get()[index] = descriptor;
 	prop->portRangeHints.get()[index] = (LADSPA_PortRangeHint) {
 		hint, min, max
@@ -211,6 +285,18 @@ static int luaI_setport(lua_State* L) {
 	return 0;
 }
 
+static int luaI_setchannel(lua_State* L) {
+	if (!lua_islightuserdata(L, 1)) luaL_error(L, "pointer excepted!");
+	PluginProperties* prop = reinterpret_cast<PluginProperties*>
+		(lua_tolightuserdata(L, 1));
+	int index = luaL_checkinteger(L, 2)-1;
+	int channel = luaL_checkinteger(L, 3)-1;
+	if (index < 0 || (size_t)index >= prop->portCount) luaL_error(L, "bad port index");
+	if (channel < 0 || channel >= prop->channels) luaL_error(L, "bad channel");
+	prop->channelPorts[channel].push_back(index);
+	return 0;
+}
+
 static int luaI_collect(lua_State* L) {
 	lua_gc(L, LUA_GCCOLLECT, 0);
 	return 0;
@@ -219,6 +305,7 @@ static int luaI_collect(lua_State* L) {
 static const luaL_Reg internal_funcs[] = {
 	{"_setvalue", luaI_setvalue},
 	{"_setport", luaI_setport},
+	{"_setchannel", luaI_setchannel},
 	{"_collect", luaI_collect},
 	{nullptr, nullptr}
 };
@@ -4,7 +4,7 @@
  */
 
 static const char internal_bcode[] = {
- 3, 90, 4, 108, 101, 
+ 3, 124, 4, 108, 101, 
  114, 112, 4, 116, 121, 
  112, 101, 6, 115, 116, 
  114, 105, 110, 103, 21, 
@@ -140,22 +140,31 @@ static const char internal_bcode[] = {
  116, 114, 105, 110, 103, 
  3, 37, 119, 42, 7, 
  100, 101, 102, 97, 117, 
- 108, 116, 6, 100, 111, 
- 80, 111, 114, 116, 5, 
- 112, 114, 111, 112, 115, 
- 9, 95, 115, 101, 116, 
- 118, 97, 108, 117, 101, 
- 8, 95, 115, 101, 116, 
- 112, 111, 114, 116, 6, 
- 108, 97, 100, 115, 112, 
- 97, 10, 103, 101, 116, 
- 86, 101, 114, 115, 105, 
- 111, 110, 5, 109, 97, 
- 107, 101, 114, 9, 99, 
- 111, 112, 121, 114, 105, 
- 103, 104, 116, 8, 114, 
- 101, 97, 108, 116, 105, 
- 109, 101, 7, 117, 110, 
+ 108, 116, 5, 108, 111, 
+ 119, 101, 114, 7, 108, 
+ 97, 116, 101, 110, 99, 
+ 121, 11, 108, 97, 116, 
+ 101, 110, 99, 121, 80, 
+ 111, 114, 116, 6, 100, 
+ 111, 80, 111, 114, 116, 
+ 5, 112, 114, 111, 112, 
+ 115, 9, 95, 115, 101, 
+ 116, 118, 97, 108, 117, 
+ 101, 8, 95, 115, 101, 
+ 116, 112, 111, 114, 116, 
+ 11, 95, 115, 101, 116, 
+ 99, 104, 97, 110, 110, 
+ 101, 108, 6, 108, 97, 
+ 100, 115, 112, 97, 10, 
+ 103, 101, 116, 86, 101, 
+ 114, 115, 105, 111, 110, 
+ 5, 109, 97, 107, 101, 
+ 114, 9, 99, 111, 112, 
+ 121, 114, 105, 103, 104, 
+ 116, 8, 114, 101, 97, 
+ 108, 116, 105, 109, 101, 
+ 6, 119, 111, 114, 107, 
+ 101, 114, 7, 117, 110, 
  110, 97, 109, 101, 100, 
  9, 110, 111, 32, 97, 
  117, 116, 104, 111, 114, 
@@ -179,46 +188,190 @@ static const char internal_bcode[] = {
  108, 32, 109, 117, 115, 
  116, 32, 98, 101, 32, 
  97, 32, 115, 116, 114, 
- 105, 110, 103, 21, 108, 
- 117, 97, 76, 97, 100, 
- 115, 112, 97, 86, 101, 
- 114, 115, 105, 111, 110, 
- 77, 97, 106, 111, 114, 
- 6, 102, 111, 114, 109, 
- 97, 116, 43, 80, 108, 
- 117, 103, 105, 110, 32, 
- 105, 115, 32, 99, 114, 
- 101, 97, 116, 101, 100, 
- 32, 102, 111, 114, 32, 
- 37, 115, 32, 108, 117, 
- 97, 108, 97, 100, 115, 
- 112, 97, 32, 118, 101, 
- 114, 115, 105, 111, 110, 
- 33, 5, 110, 101, 119, 
- 101, 114, 5, 111, 108, 
- 100, 101, 114, 21, 108, 
- 117, 97, 76, 97, 100, 
- 115, 112, 97, 86, 101, 
- 114, 115, 105, 111, 110, 
- 77, 105, 110, 111, 114, 
- 52, 80, 108, 117, 103, 
- 105, 110, 32, 105, 115, 
- 32, 99, 114, 101, 97, 
- 116, 101, 100, 32, 102, 
- 111, 114, 32, 110, 101, 
- 119, 101, 114, 32, 109, 
- 105, 110, 111, 114, 32, 
- 108, 117, 97, 108, 97, 
- 100, 115, 112, 97, 32, 
- 118, 101, 114, 115, 105, 
- 111, 110, 33, 5, 112, 
- 111, 114, 116, 115, 28, 
- 112, 111, 114, 116, 115, 
- 32, 116, 97, 98, 108, 
+ 105, 110, 103, 5, 91, 
+ 13, 10, 9, 93, 4, 
+ 102, 105, 110, 100, 45, 
+ 105, 110, 102, 111, 46, 
+ 108, 97, 98, 101, 108, 
+ 32, 109, 117, 115, 116, 
+ 32, 98, 101, 32, 97, 
+ 32, 115, 105, 110, 103, 
+ 108, 101, 32, 108, 105, 
+ 110, 101, 32, 119, 105, 
+ 116, 104, 111, 117, 116, 
+ 32, 116, 97, 98, 115, 
+ 2, 105, 100, 45, 105, 
+ 110, 102, 111, 46, 105, 
+ 100, 32, 109, 117, 115, 
+ 116, 32, 98, 101, 32, 
+ 105, 110, 116, 101, 103, 
+ 101, 114, 32, 105, 110, 
+ 32, 114, 97, 110, 103, 
+ 101, 32, 49, 46, 46, 
+ 49, 54, 55, 55, 55, 
+ 50, 49, 53, 33, 21, 
+ 108, 117, 97, 76, 97, 
+ 100, 115, 112, 97, 86, 
+ 101, 114, 115, 105, 111, 
+ 110, 77, 97, 106, 111, 
+ 114, 6, 102, 111, 114, 
+ 109, 97, 116, 43, 80, 
+ 108, 117, 103, 105, 110, 
+ 32, 105, 115, 32, 99, 
+ 114, 101, 97, 116, 101, 
+ 100, 32, 102, 111, 114, 
+ 32, 37, 115, 32, 108, 
+ 117, 97, 108, 97, 100, 
+ 115, 112, 97, 32, 118, 
+ 101, 114, 115, 105, 111, 
+ 110, 33, 5, 110, 101, 
+ 119, 101, 114, 5, 111, 
+ 108, 100, 101, 114, 21, 
+ 108, 117, 97, 76, 97, 
+ 100, 115, 112, 97, 86, 
+ 101, 114, 115, 105, 111, 
+ 110, 77, 105, 110, 111, 
+ 114, 52, 80, 108, 117, 
+ 103, 105, 110, 32, 105, 
+ 115, 32, 99, 114, 101, 
+ 97, 116, 101, 100, 32, 
+ 102, 111, 114, 32, 110, 
+ 101, 119, 101, 114, 32, 
+ 109, 105, 110, 111, 114, 
+ 32, 108, 117, 97, 108, 
+ 97, 100, 115, 112, 97, 
+ 32, 118, 101, 114, 115, 
+ 105, 111, 110, 33, 10, 
+ 111, 118, 101, 114, 115, 
+ 97, 109, 112, 108, 101, 
+ 37, 105, 110, 102, 111, 
+ 46, 111, 118, 101, 114, 
+ 115, 97, 109, 112, 108, 
  101, 32, 109, 117, 115, 
  116, 32, 98, 101, 32, 
- 99, 114, 101, 97, 116, 
- 101, 100, 33, 38, 80, 
+ 49, 44, 32, 50, 44, 
+ 32, 52, 32, 111, 114, 
+ 32, 56, 33, 5, 97, 
+ 115, 121, 110, 99, 57, 
+ 105, 110, 102, 111, 46, 
+ 97, 115, 121, 110, 99, 
+ 32, 109, 117, 115, 116, 
+ 32, 98, 101, 32, 116, 
+ 114, 117, 101, 32, 111, 
+ 114, 32, 98, 108, 111, 
+ 99, 107, 32, 115, 105, 
+ 122, 101, 32, 105, 110, 
+ 32, 114, 97, 110, 103, 
+ 101, 32, 51, 50, 46, 
+ 46, 54, 53, 53, 51, 
+ 54, 33, 38, 114, 101, 
+ 97, 108, 116, 105, 109, 
+ 101, 32, 112, 108, 117, 
+ 103, 105, 110, 32, 99, 
+ 97, 110, 39, 116, 32, 
+ 98, 101, 32, 97, 115, 
+ 121, 110, 99, 104, 114, 
+ 111, 110, 111, 117, 115, 
+ 33, 14, 102, 108, 117, 
+ 115, 104, 68, 101, 110, 
+ 111, 114, 109, 97, 108, 
+ 115, 7, 98, 111, 111, 
+ 108, 101, 97, 110, 35, 
+ 105, 110, 102, 111, 46, 
+ 102, 108, 117, 115, 104, 
+ 68, 101, 110, 111, 114, 
+ 109, 97, 108, 115, 32, 
+ 109, 117, 115, 116, 32, 
+ 98, 101, 32, 98, 111, 
+ 111, 108, 101, 97, 110, 
+ 5, 99, 111, 117, 110, 
+ 116, 4, 102, 97, 105, 
+ 108, 6, 115, 116, 114, 
+ 105, 99, 116, 51, 105, 
+ 110, 102, 111, 46, 115, 
+ 116, 114, 105, 99, 116, 
+ 32, 109, 117, 115, 116, 
+ 32, 98, 101, 32, 116, 
+ 114, 117, 101, 44, 32, 
+ 34, 99, 111, 117, 110, 
+ 116, 34, 44, 32, 34, 
+ 108, 111, 103, 34, 32, 
+ 111, 114, 32, 34, 102, 
+ 97, 105, 108, 34, 33, 
+ 6, 119, 97, 114, 109, 
+ 117, 112, 37, 105, 110, 
+ 102, 111, 46, 119, 97, 
+ 114, 109, 117, 112, 32, 
+ 109, 117, 115, 116, 32, 
+ 98, 101, 32, 110, 117, 
+ 109, 98, 101, 114, 32, 
+ 111, 102, 32, 98, 108, 
+ 111, 99, 107, 115, 33, 
+ 4, 112, 111, 111, 108, 
+ 53, 105, 110, 102, 111, 
+ 46, 112, 111, 111, 108, 
+ 32, 109, 117, 115, 116, 
+ 32, 98, 101, 32, 110, 
+ 117, 109, 98, 101, 114, 
+ 32, 111, 102, 32, 105, 
+ 110, 115, 116, 97, 110, 
+ 99, 101, 115, 32, 105, 
+ 110, 32, 114, 97, 110, 
+ 103, 101, 32, 48, 46, 
+ 46, 54, 52, 33, 8, 
+ 112, 111, 111, 108, 83, 
+ 105, 122, 101, 8, 115, 
+ 110, 97, 112, 115, 104, 
+ 111, 116, 29, 105, 110, 
+ 102, 111, 46, 115, 110, 
+ 97, 112, 115, 104, 111, 
+ 116, 32, 109, 117, 115, 
+ 116, 32, 98, 101, 32, 
+ 98, 111, 111, 108, 101, 
+ 97, 110, 5, 112, 111, 
+ 114, 116, 115, 28, 112, 
+ 111, 114, 116, 115, 32, 
+ 116, 97, 98, 108, 101, 
+ 32, 109, 117, 115, 116, 
+ 32, 98, 101, 32, 99, 
+ 114, 101, 97, 116, 101, 
+ 100, 33, 5, 116, 97, 
+ 98, 108, 101, 41, 112, 
+ 111, 114, 116, 115, 32, 
+ 109, 117, 115, 116, 32, 
+ 98, 101, 32, 112, 114, 
+ 111, 112, 101, 114, 32, 
+ 108, 117, 97, 32, 97, 
+ 114, 114, 97, 121, 32, 
+ 111, 102, 32, 116, 97, 
+ 98, 108, 101, 115, 33, 
+ 8, 99, 104, 97, 110, 
+ 110, 101, 108, 115, 58, 
+ 99, 104, 97, 110, 110, 
+ 101, 108, 115, 32, 109, 
+ 117, 115, 116, 32, 98, 
+ 101, 32, 97, 110, 32, 
+ 105, 110, 116, 101, 103, 
+ 101, 114, 32, 105, 110, 
+ 32, 114, 97, 110, 103, 
+ 101, 32, 49, 46, 46, 
+ 54, 52, 32, 40, 112, 
+ 111, 114, 116, 32, 105, 
+ 110, 100, 101, 120, 32, 
+ 105, 115, 32, 2, 32, 
+ 41, 53, 97, 108, 108, 
+ 32, 99, 104, 97, 110, 
+ 110, 101, 108, 32, 103, 
+ 114, 111, 117, 112, 115, 
+ 32, 109, 117, 115, 116, 
+ 32, 104, 97, 118, 101, 
+ 32, 115, 97, 109, 101, 
+ 32, 110, 117, 109, 98, 
+ 101, 114, 32, 111, 102, 
+ 32, 99, 104, 97, 110, 
+ 110, 101, 108, 115, 33, 
+ 5, 99, 108, 111, 110, 
+ 101, 1, 32, 38, 80, 
  108, 117, 103, 105, 110, 
  32, 109, 117, 115, 116, 
  32, 99, 111, 110, 116, 
@@ -231,47 +384,37 @@ static const char internal_bcode[] = {
  110, 116, 3, 108, 111, 
  119, 6, 109, 105, 100, 
  100, 108, 101, 4, 104, 
- 105, 103, 104, 5, 116, 
- 97, 98, 108, 101, 41, 
- 112, 111, 114, 116, 115, 
- 32, 109, 117, 115, 116, 
- 32, 98, 101, 32, 112, 
- 114, 111, 112, 101, 114, 
- 32, 108, 117, 97, 32, 
- 97, 114, 114, 97, 121, 
- 32, 111, 102, 32, 116, 
- 97, 98, 108, 101, 115, 
- 33, 5, 112, 99, 97, 
- 108, 108, 16, 32, 40, 
- 112, 111, 114, 116, 32, 
- 105, 110, 100, 101, 120, 
- 32, 105, 115, 32, 2, 
- 32, 41, 2, 95, 71, 
- 6, 102, 114, 101, 101, 
- 122, 101, 42, 80, 108, 
- 117, 103, 105, 110, 32, 
- 105, 110, 105, 116, 105, 
- 97, 108, 105, 122, 97, 
- 116, 105, 111, 110, 32, 
- 105, 115, 32, 68, 79, 
- 78, 69, 32, 115, 117, 
- 99, 101, 115, 115, 102, 
- 117, 108, 108, 121, 33, 
- 8, 95, 99, 111, 108, 
- 108, 101, 99, 116, 6, 
- 5, 3, 0, 0, 8, 
- 34, 0, 0, 1, 34, 
- 3, 2, 1, 79, 3, 
- 3, 0, 0, 0, 0, 
- 0, 4, 4, 1, 0, 
- 22, 4, 2, 0, 4, 
- 4, 1, 0, 22, 4, 
- 2, 0, 1, 2, 0, 
+ 105, 103, 104, 5, 112, 
+ 99, 97, 108, 108, 16, 
+ 32, 40, 112, 111, 114, 
+ 116, 32, 105, 110, 100, 
+ 101, 120, 32, 105, 115, 
+ 32, 2, 95, 71, 6, 
+ 102, 114, 101, 101, 122, 
+ 101, 42, 80, 108, 117, 
+ 103, 105, 110, 32, 105, 
+ 110, 105, 116, 105, 97, 
+ 108, 105, 122, 97, 116, 
+ 105, 111, 110, 32, 105, 
+ 115, 32, 68, 79, 78, 
+ 69, 32, 115, 117, 99, 
+ 101, 115, 115, 102, 117, 
+ 108, 108, 121, 33, 8, 
+ 95, 99, 111, 108, 108, 
+ 101, 99, 116, 6, 5, 
+ 3, 0, 0, 8, 34, 
+ 0, 0, 1, 34, 3, 
+ 2, 1, 79, 3, 3, 
  0, 0, 0, 0, 0, 
- 0, 0, 0, 83, 1, 
+ 4, 4, 1, 0, 22, 
+ 4, 2, 0, 4, 4, 
+ 1, 0, 22, 4, 2, 
+ 0, 1, 2, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, -69, 1, 1, 
  1, 24, 0, 1, 1, 
  0, 1, 0, 2, 0, 
- 84, 0, 0, 0, 0, 
+ -68, 0, 0, 0, 0, 
  10, 3, 3, 0, 65, 
  73, 40, 0, 3, 6, 
  4, 0, 0, 12, 3, 
@@ -338,742 +481,1272 @@ static const char internal_bcode[] = {
  3, 10, 3, 11, 4, 
  0, 0, -32, 64, 3, 
  12, 4, 0, 0, 0, 
- 65, 3, 13, 0, 92, 
- 14, 1, 24, 0, 0, 
+ 65, 3, 13, 0, -60, 
+ 1, 14, 1, 24, 0, 
  0, 0, 0, 0, 0, 
- 1, 0, 0, 0, 0, 
- 0, 0, 0, 1, 0, 
  0, 1, 0, 0, 0, 
- 0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 1, 0, 0, 
  0, 0, 0, 0, 1, 
  0, 0, 0, 0, 0, 
  1, 0, 0, 0, 0, 
+ 0, 1, 0, 0, 0, 
  0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 1, 0, 0, 2, 0, 
- 0, 0, 1, 93, 0, 
- 0, 0, 0, 3, 1, 
- 2, 0, 49, 80, 0, 
- 11, 0, 0, 0, 0, 
- -128, 9, 1, 0, 0, 
- 78, 1, 5, 0, 1, 
- 0, 0, -128, 12, 1, 
- 2, 0, 0, 0, 16, 
- 64, 5, 2, 3, 0, 
- 21, 1, 2, 1, 3, 
- 1, 0, 0, 10, 1, 
- 0, 0, 23, 0, 35, 
- 0, 80, 0, 11, 0, 
- 4, 0, 0, -128, 9, 
- 1, 0, 0, 78, 1, 
- 5, 0, 0, 0, 0, 
- -128, 12, 1, 2, 0, 
- 0, 0, 16, 64, 5, 
- 2, 5, 0, 21, 1, 
- 2, 1, 3, 1, 1, 
- 0, 10, 1, 0, 0, 
- 23, 0, 23, 0, 80, 
- 0, 11, 0, 6, 0, 
- 0, -128, 9, 1, 1, 
+ 0, 1, 0, 0, 2, 
+ 0, 0, 0, 1, -59, 
+ 0, 0, 0, 0, 3, 
+ 1, 2, 0, 49, 80, 
+ 0, 11, 0, 0, 0, 
+ 0, -128, 9, 1, 0, 
  0, 78, 1, 5, 0, 
- 0, 0, 0, -128, 12, 
+ 1, 0, 0, -128, 12, 
  1, 2, 0, 0, 0, 
- 16, 64, 5, 2, 7, 
+ 16, 64, 5, 2, 3, 
  0, 21, 1, 2, 1, 
- 3, 1, 1, 0, 10, 
- 1, 1, 0, 23, 0, 
- 11, 0, 80, 0, 10, 
- 0, 8, 0, 0, -128, 
- 9, 1, 1, 0, 78, 
- 1, 5, 0, 1, 0, 
+ 3, 1, 0, 0, 10, 
+ 1, 0, 0, 23, 0, 
+ 35, 0, 80, 0, 11, 
+ 0, 4, 0, 0, -128, 
+ 9, 1, 0, 0, 78, 
+ 1, 5, 0, 0, 0, 
  0, -128, 12, 1, 2, 
  0, 0, 0, 16, 64, 
- 5, 2, 9, 0, 21, 
+ 5, 2, 5, 0, 21, 
  1, 2, 1, 3, 1, 
- 0, 0, 10, 1, 1, 
- 0, 5, 1, 10, 0, 
- 22, 1, 2, 0, 11, 
- 3, 15, 3, 16, 4, 
- 0, 0, 16, 64, 3, 
- 17, 3, 18, 3, 19, 
- 3, 20, 3, 21, 3, 
- 22, 3, 23, 3, 24, 
- 0, 108, 25, 1, 24, 
- 0, 0, 1, 0, 0, 
- 1, 0, 0, 0, 2, 
- 0, 0, 1, 0, 1, 
+ 1, 0, 10, 1, 0, 
+ 0, 23, 0, 23, 0, 
+ 80, 0, 11, 0, 6, 
+ 0, 0, -128, 9, 1, 
+ 1, 0, 78, 1, 5, 
+ 0, 0, 0, 0, -128, 
+ 12, 1, 2, 0, 0, 
+ 0, 16, 64, 5, 2, 
+ 7, 0, 21, 1, 2, 
+ 1, 3, 1, 1, 0, 
+ 10, 1, 1, 0, 23, 
+ 0, 11, 0, 80, 0, 
+ 10, 0, 8, 0, 0, 
+ -128, 9, 1, 1, 0, 
+ 78, 1, 5, 0, 1, 
+ 0, 0, -128, 12, 1, 
+ 2, 0, 0, 0, 16, 
+ 64, 5, 2, 9, 0, 
+ 21, 1, 2, 1, 3, 
+ 1, 0, 0, 10, 1, 
+ 1, 0, 5, 1, 10, 
+ 0, 22, 1, 2, 0, 
+ 11, 3, 15, 3, 16, 
+ 4, 0, 0, 16, 64, 
+ 3, 17, 3, 18, 3, 
+ 19, 3, 20, 3, 21, 
+ 3, 22, 3, 23, 3, 
+ 24, 0, -44, 1, 25, 
+ 1, 24, 0, 0, 1, 
  0, 0, 1, 0, 0, 
  0, 2, 0, 0, 1, 
  0, 1, 0, 0, 1, 
  0, 0, 0, 2, 0, 
  0, 1, 0, 1, 0, 
  0, 1, 0, 0, 0, 
- 2, 0, 2, 0, 109, 
- 0, 0, 0, 0, 6, 
- 1, 3, 0, 53, 80, 
- 0, 8, 0, 0, 0, 
- 0, -128, 4, 1, 4, 
- 0, 10, 1, 0, 0, 
+ 2, 0, 0, 1, 0, 
+ 1, 0, 0, 1, 0, 
+ 0, 0, 2, 0, 2, 
+ 0, -43, 0, 0, 0, 
+ 0, 6, 1, 3, 0, 
+ 53, 80, 0, 8, 0, 
+ 0, 0, 0, -128, 4, 
+ 1, 4, 0, 10, 1, 
+ 0, 0, 2, 1, 0, 
+ 0, 10, 1, 1, 0, 
  2, 1, 0, 0, 10, 
- 1, 1, 0, 2, 1, 
- 0, 0, 10, 1, 2, 
+ 1, 2, 0, 22, 0, 
+ 1, 0, 9, 1, 0, 
+ 0, 79, 1, 9, 0, 
+ 1, 0, 0, -128, 12, 
+ 1, 3, 0, 0, 0, 
+ 32, 64, 5, 3, 4, 
+ 0, 6, 4, 0, 0, 
+ 5, 5, 5, 0, 49, 
+ 2, 3, 5, 21, 1, 
+ 2, 1, 22, 0, 1, 
+ 0, 80, 0, 10, 0, 
+ 6, 0, 0, -128, 9, 
+ 2, 0, 0, 75, 31, 
+ 2, 4, 7, 0, 0, 
+ 0, 5, 3, 7, 0, 
+ 12, 1, 10, 0, 0, 
+ 36, -128, -128, 21, 1, 
+ 3, 2, 10, 1, 0, 
  0, 22, 0, 1, 0, 
- 9, 1, 0, 0, 79, 
- 1, 9, 0, 1, 0, 
- 0, -128, 12, 1, 3, 
- 0, 0, 0, 32, 64, 
- 5, 3, 4, 0, 6, 
- 4, 0, 0, 5, 5, 
- 5, 0, 49, 2, 3, 
- 5, 21, 1, 2, 1, 
+ 80, 0, 10, 0, 11, 
+ 0, 0, -128, 9, 2, 
+ 0, 0, 75, 31, 2, 
+ 4, 12, 0, 0, 0, 
+ 5, 3, 12, 0, 12, 
+ 1, 10, 0, 0, 36, 
+ -128, -128, 21, 1, 3, 
+ 2, 10, 1, 0, 0, 
  22, 0, 1, 0, 80, 
- 0, 10, 0, 6, 0, 
+ 0, 9, 0, 13, 0, 
  0, -128, 9, 2, 0, 
  0, 75, 31, 2, 4, 
- 7, 0, 0, 0, 5, 
- 3, 7, 0, 12, 1, 
+ 14, 0, 0, 0, 5, 
+ 3, 14, 0, 12, 1, 
  10, 0, 0, 36, -128, 
  -128, 21, 1, 3, 2, 
  10, 1, 0, 0, 22, 
- 0, 1, 0, 80, 0, 
- 10, 0, 11, 0, 0, 
- -128, 9, 2, 0, 0, 
- 75, 31, 2, 4, 12, 
- 0, 0, 0, 5, 3, 
- 12, 0, 12, 1, 10, 
- 0, 0, 36, -128, -128, 
- 21, 1, 3, 2, 10, 
- 1, 0, 0, 22, 0, 
- 1, 0, 80, 0, 9, 
- 0, 13, 0, 0, -128, 
- 9, 2, 0, 0, 75, 
- 31, 2, 4, 14, 0, 
- 0, 0, 5, 3, 14, 
- 0, 12, 1, 10, 0, 
- 0, 36, -128, -128, 21, 
- 1, 3, 2, 10, 1, 
- 0, 0, 22, 0, 1, 
- 0, 15, 3, 26, 2, 
- 0, 0, 0, 0, 0, 
- 0, 16, 64, 3, 16, 
- 4, 0, 0, 32, 64, 
- 3, 27, 3, 28, 3, 
- 29, 2, 0, 0, 0, 
- 0, 0, 0, 48, 64, 
- 3, 30, 3, 31, 4, 
- 0, 36, -128, -128, 3, 
- 32, 2, 0, 0, 0, 
- 0, 0, 0, 64, 64, 
- 3, 33, 2, 0, 0, 
- 0, 0, 0, 0, 32, 
- 64, 0, -123, 1, 34, 
- 1, 24, 0, 0, 1, 
- 0, 1, 0, 1, 0, 
- 10, -9, 0, 0, 1, 
+ 0, 1, 0, 15, 3, 
+ 26, 2, 0, 0, 0, 
+ 0, 0, 0, 16, 64, 
+ 3, 16, 4, 0, 0, 
+ 32, 64, 3, 27, 3, 
+ 28, 3, 29, 2, 0, 
  0, 0, 0, 0, 0, 
- 0, 8, -7, 0, 1, 
+ 48, 64, 3, 30, 3, 
+ 31, 4, 0, 36, -128, 
+ -128, 3, 32, 2, 0, 
  0, 0, 0, 0, 0, 
- 0, 0, 6, -5, 0, 
- 1, 0, 0, 0, 0, 
- 0, 0, 0, 4, -3, 
+ 64, 64, 3, 33, 2, 
+ 0, 0, 0, 0, 0, 
+ 0, 32, 64, 0, -19, 
+ 1, 34, 1, 24, 0, 
+ 0, 1, 0, 1, 0, 
+ 1, 0, 10, -9, 0, 
  0, 1, 0, 0, 0, 
- 0, 0, 0, 0, 2, 
- -122, 0, 0, 0, 0, 
- 12, 2, 11, 0, -45, 
- 1, 2, 2, 0, 0, 
- 10, 2, 0, 0, 2, 
+ 0, 0, 0, 8, -7, 
+ 0, 1, 0, 0, 0, 
+ 0, 0, 0, 0, 6, 
+ -5, 0, 1, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 4, -3, 0, 1, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 2, -18, 0, 0, 
+ 0, 0, 12, 2, 12, 
+ 0, -30, 1, 2, 2, 
+ 0, 0, 10, 2, 0, 
+ 0, 2, 2, 0, 0, 
+ 10, 2, 1, 0, 2, 
  2, 0, 0, 10, 2, 
- 1, 0, 2, 2, 0, 
- 0, 10, 2, 2, 0, 
+ 2, 0, 2, 2, 0, 
+ 0, 10, 2, 3, 0, 
  2, 2, 0, 0, 10, 
- 2, 3, 0, 2, 2, 
- 0, 0, 10, 2, 4, 
- 0, 2, 2, 0, 0, 
- 10, 2, 5, 0, 15, 
- 2, 0, 113, 0, 0, 
- 0, 0, 73, 40, 2, 
- 3, 6, 6, 2, 0, 
- 12, 5, 1, 0, 0, 
- 0, 0, 64, 21, 5, 
- 2, 2, 80, 5, 2, 
- 0, 2, 0, 0, 0, 
+ 2, 4, 0, 2, 2, 
+ 0, 0, 10, 2, 5, 
+ 0, 15, 2, 0, 113, 
+ 0, 0, 0, 0, 73, 
+ 40, 2, 3, 6, 6, 
+ 2, 0, 12, 5, 1, 
+ 0, 0, 0, 0, 64, 
+ 21, 5, 2, 2, 80, 
+ 5, 2, 0, 2, 0, 
+ 0, 0, 3, 4, 0, 
+ 1, 3, 4, 1, 0, 
+ 75, 1, 4, 4, 3, 
+ 0, 0, 0, 5, 5, 
+ 3, 0, 12, 3, 5, 
+ 0, 0, 0, 64, 64, 
+ 21, 3, 3, 1, 5, 
+ 5, 6, 0, 9, 6, 
+ 6, 0, 20, 3, 2, 
+ -52, 7, 0, 0, 0, 
+ 21, 3, 4, 1, 9, 
+ 5, 1, 0, 77, 5, 
+ 2, 0, 0, 0, 0, 
+ -128, 3, 4, 0, 1, 
+ 3, 4, 1, 0, 75, 
+ 1, 4, 4, 8, 0, 
+ 0, 0, 5, 5, 8, 
+ 0, 12, 3, 5, 0, 
+ 0, 0, 64, 64, 21, 
+ 3, 3, 1, 9, 5, 
+ 0, 0, 77, 5, 2, 
+ 0, 0, 0, 0, -128, 
  3, 4, 0, 1, 3, 
  4, 1, 0, 75, 1, 
- 4, 4, 3, 0, 0, 
- 0, 5, 5, 3, 0, 
+ 4, 4, 9, 0, 0, 
+ 0, 5, 5, 9, 0, 
  12, 3, 5, 0, 0, 
  0, 64, 64, 21, 3, 
- 3, 1, 5, 5, 6, 
- 0, 9, 6, 6, 0, 
- 20, 3, 2, -52, 7, 
- 0, 0, 0, 21, 3, 
- 4, 1, 9, 5, 1, 
- 0, 77, 5, 2, 0, 
- 0, 0, 0, -128, 3, 
- 4, 0, 1, 3, 4, 
- 1, 0, 75, 1, 4, 
- 4, 8, 0, 0, 0, 
- 5, 5, 8, 0, 12, 
- 3, 5, 0, 0, 0, 
- 64, 64, 21, 3, 3, 
- 1, 9, 5, 0, 0, 
- 77, 5, 2, 0, 0, 
- 0, 0, -128, 3, 4, 
+ 3, 1, 15, 3, 0, 
+ 90, 10, 0, 0, 0, 
+ 25, 3, 6, 0, 5, 
+ 4, 11, 0, 12, 5, 
+ 13, 0, 0, 0, -64, 
+ 64, 6, 6, 1, 0, 
+ 21, 5, 2, 2, 49, 
+ 3, 4, 5, 6, 2, 
+ 3, 0, 16, 2, 0, 
+ 90, 10, 0, 0, 0, 
+ 73, 40, 2, 3, 6, 
+ 6, 2, 0, 12, 5, 
+ 1, 0, 0, 0, 0, 
+ 64, 21, 5, 2, 2, 
+ 80, 5, 2, 0, 2, 
+ 0, 0, 0, 3, 4, 
  0, 1, 3, 4, 1, 
  0, 75, 1, 4, 4, 
- 9, 0, 0, 0, 5, 
- 5, 9, 0, 12, 3, 
+ 14, 0, 0, 0, 5, 
+ 5, 14, 0, 12, 3, 
  5, 0, 0, 0, 64, 
  64, 21, 3, 3, 1, 
- 15, 3, 0, 90, 10, 
- 0, 0, 0, 25, 3, 
- 6, 0, 5, 4, 11, 
- 0, 12, 5, 13, 0, 
- 0, 0, -64, 64, 6, 
- 6, 1, 0, 21, 5, 
- 2, 2, 49, 3, 4, 
- 5, 6, 2, 3, 0, 
- 16, 2, 0, 90, 10, 
- 0, 0, 0, 73, 40, 
- 2, 3, 6, 6, 2, 
- 0, 12, 5, 1, 0, 
- 0, 0, 0, 64, 21, 
- 5, 2, 2, 80, 5, 
- 2, 0, 2, 0, 0, 
- 0, 3, 4, 0, 1, 
- 3, 4, 1, 0, 75, 
- 1, 4, 4, 14, 0, 
- 0, 0, 5, 5, 14, 
- 0, 12, 3, 5, 0, 
- 0, 0, 64, 64, 21, 
- 3, 3, 1, 10, 2, 
- 5, 0, 15, 2, 0, 
- -72, 15, 0, 0, 0, 
- 10, 2, 2, 0, 9, 
+ 10, 2, 5, 0, 15, 
+ 2, 0, -72, 15, 0, 
+ 0, 0, 10, 2, 2, 
+ 0, 9, 3, 2, 0, 
+ 26, 3, 15, 0, 73, 
+ 40, 2, 3, 6, 6, 
+ 2, 0, 12, 5, 1, 
+ 0, 0, 0, 0, 64, 
+ 21, 5, 2, 2, 80, 
+ 5, 2, 0, 16, 0, 
+ 0, 0, 3, 4, 0, 
+ 1, 3, 4, 1, 0, 
+ 75, 1, 4, 4, 17, 
+ 0, 0, 0, 5, 5, 
+ 17, 0, 12, 3, 5, 
+ 0, 0, 0, 64, 64, 
+ 21, 3, 3, 1, 15, 
+ 2, 0, -108, 18, 0, 
+ 0, 0, 10, 2, 3, 
+ 0, 9, 3, 3, 0, 
+ 26, 3, 15, 0, 73, 
+ 40, 2, 3, 6, 6, 
+ 2, 0, 12, 5, 1, 
+ 0, 0, 0, 0, 64, 
+ 21, 5, 2, 2, 80, 
+ 5, 2, 0, 16, 0, 
+ 0, 0, 3, 4, 0, 
+ 1, 3, 4, 1, 0, 
+ 75, 1, 4, 4, 19, 
+ 0, 0, 0, 5, 5, 
+ 19, 0, 12, 3, 5, 
+ 0, 0, 0, 64, 64, 
+ 21, 3, 3, 1, 15, 
+ 3, 0, 47, 21, 0, 
+ 0, 0, 48, 2, 3, 
+ 20, 4, 3, 0, 0, 
+ 10, 3, 4, 0, 9, 
  3, 2, 0, 26, 3, 
- 15, 0, 73, 40, 2, 
- 3, 6, 6, 2, 0, 
- 12, 5, 1, 0, 0, 
- 0, 0, 64, 21, 5, 
- 2, 2, 80, 5, 2, 
- 0, 16, 0, 0, 0, 
- 3, 4, 0, 1, 3, 
- 4, 1, 0, 75, 1, 
- 4, 4, 17, 0, 0, 
- 0, 5, 5, 17, 0, 
- 12, 3, 5, 0, 0, 
- 0, 64, 64, 21, 3, 
- 3, 1, 15, 2, 0, 
- -108, 18, 0, 0, 0, 
- 10, 2, 3, 0, 9, 
+ 8, 0, 9, 4, 4, 
+ 0, 75, 31, 4, 4, 
+ 22, 0, 0, 0, 5, 
+ 5, 22, 0, 12, 3, 
+ 25, 0, 0, 96, 112, 
+ -127, 21, 3, 3, 2, 
+ 10, 3, 4, 0, 9, 
  3, 3, 0, 26, 3, 
- 15, 0, 73, 40, 2, 
- 3, 6, 6, 2, 0, 
- 12, 5, 1, 0, 0, 
- 0, 0, 64, 21, 5, 
- 2, 2, 80, 5, 2, 
- 0, 16, 0, 0, 0, 
- 3, 4, 0, 1, 3, 
- 4, 1, 0, 75, 1, 
- 4, 4, 19, 0, 0, 
- 0, 5, 5, 19, 0, 
- 12, 3, 5, 0, 0, 
- 0, 64, 64, 21, 3, 
- 3, 1, 15, 3, 0, 
- 47, 21, 0, 0, 0, 
- 48, 2, 3, 20, 4, 
- 3, 0, 0, 10, 3, 
- 4, 0, 9, 3, 2, 
- 0, 26, 3, 8, 0, 
- 9, 4, 4, 0, 75, 
- 31, 4, 4, 22, 0, 
- 0, 0, 5, 5, 22, 
- 0, 12, 3, 25, 0, 
- 0, 96, 112, -127, 21, 
- 3, 3, 2, 10, 3, 
- 4, 0, 9, 3, 3, 
- 0, 26, 3, 8, 0, 
- 9, 4, 4, 0, 75, 
- 31, 4, 4, 26, 0, 
- 0, 0, 5, 5, 26, 
- 0, 12, 3, 25, 0, 
- 0, 96, 112, -127, 21, 
- 3, 3, 2, 10, 3, 
- 4, 0, 73, 40, 2, 
- 3, 6, 6, 2, 0, 
- 12, 5, 1, 0, 0, 
- 0, 0, 64, 21, 5, 
- 2, 2, 80, 5, 2, 
- 0, 2, 0, 0, 0, 
- 3, 4, 0, 1, 3, 
- 4, 1, 0, 75, 1, 
- 4, 4, 27, 0, 0, 
- 0, 5, 5, 27, 0, 
- 12, 3, 5, 0, 0, 
- 0, 64, 64, 21, 3, 
- 3, 1, 5, 5, 28, 
- 0, 9, 6, 7, 0, 
- 20, 3, 2, -52, 7, 
- 0, 0, 0, 21, 3, 
- 4, 1, 15, 3, 0, 
- 26, 29, 0, 0, 0, 
- 26, 3, 14, 0, 9, 
- 4, 4, 0, 9, 5, 
- 8, 0, 15, 6, 0, 
- 26, 29, 0, 0, 0, 
- 9, 8, 2, 0, 48, 
- 7, 8, 30, 9, 9, 
- 3, 0, 48, 8, 9, 
- 22, 21, 5, 4, 0, 
- 68, 31, 0, 2, 12, 
- 3, 25, 0, 0, 96, 
- 112, -127, 21, 3, 0, 
- 2, 10, 3, 4, 0, 
- 9, 5, 0, 0, 26, 
- 5, 2, 0, 4, 4, 
- 2, 0, 23, 0, 1, 
- 0, 4, 4, 1, 0, 
- 9, 6, 1, 0, 26, 
- 6, 2, 0, 4, 5, 
- 4, 0, 23, 0, 1, 
- 0, 4, 5, 8, 0, 
- 74, 31, 4, 3, 5, 
- 0, 0, 0, 12, 3, 
+ 8, 0, 9, 4, 4, 
+ 0, 75, 31, 4, 4, 
+ 26, 0, 0, 0, 5, 
+ 5, 26, 0, 12, 3, 
  25, 0, 0, 96, 112, 
  -127, 21, 3, 3, 2, 
- 9, 4, 9, 0, 9, 
- 5, 10, 0, 6, 6, 
- 1, 0, 9, 7, 5, 
- 0, 6, 8, 3, 0, 
- 9, 9, 4, 0, 9, 
- 10, 2, 0, 9, 11, 
- 3, 0, 21, 4, 8, 
- 1, 22, 0, 1, 0, 
- 31, 3, 2, 4, 0, 
- 0, 0, 64, 3, 3, 
- 3, 35, 3, 5, 4, 
- 0, 0, 64, 64, 3, 
- 36, 3, 37, 3, 38, 
- 3, 39, 3, 40, 3, 
- 41, 3, 11, 4, 0, 
- 0, -64, 64, 3, 42, 
- 3, 43, 3, 6, 3, 
- 44, 3, 45, 3, 46, 
- 3, 24, 3, 47, 2, 
- 0, 0, 0, 0, 0, 
- 0, -16, 63, 3, 30, 
- 3, 31, 4, 0, 96, 
- 112, -127, 2, 0, 0, 
- 0, 0, 0, 0, 0, 
- 64, 3, 48, 3, 49, 
- 3, 50, 2, 0, 0, 
- 0, 0, 0, 0, 0, 
- 0, 0, -107, 1, 51, 
- 1, 24, 0, 0, 1, 
- 0, 1, 0, 1, 0, 
- 1, 0, 1, 0, 2, 
- 0, 1, 0, 0, 0, 
+ 10, 3, 4, 0, 73, 
+ 40, 2, 3, 6, 6, 
+ 2, 0, 12, 5, 1, 
+ 0, 0, 0, 0, 64, 
+ 21, 5, 2, 2, 80, 
+ 5, 2, 0, 2, 0, 
+ 0, 0, 3, 4, 0, 
+ 1, 3, 4, 1, 0, 
+ 75, 1, 4, 4, 27, 
+ 0, 0, 0, 5, 5, 
+ 27, 0, 12, 3, 5, 
+ 0, 0, 0, 64, 64, 
+ 21, 3, 3, 1, 5, 
+ 5, 28, 0, 9, 6, 
+ 7, 0, 20, 3, 2, 
+ -52, 7, 0, 0, 0, 
+ 21, 3, 4, 1, 15, 
+ 3, 0, 26, 29, 0, 
+ 0, 0, 26, 3, 14, 
+ 0, 9, 4, 4, 0, 
+ 9, 5, 8, 0, 15, 
+ 6, 0, 26, 29, 0, 
+ 0, 0, 9, 8, 2, 
+ 0, 48, 7, 8, 30, 
+ 9, 9, 3, 0, 48, 
+ 8, 9, 22, 21, 5, 
+ 4, 0, 68, 31, 0, 
+ 2, 12, 3, 25, 0, 
+ 0, 96, 112, -127, 21, 
+ 3, 0, 2, 10, 3, 
+ 4, 0, 9, 5, 0, 
+ 0, 26, 5, 2, 0, 
+ 4, 4, 2, 0, 23, 
+ 0, 1, 0, 4, 4, 
+ 1, 0, 9, 6, 1, 
+ 0, 26, 6, 2, 0, 
+ 4, 5, 4, 0, 23, 
+ 0, 1, 0, 4, 5, 
+ 8, 0, 74, 31, 4, 
+ 3, 5, 0, 0, 0, 
+ 12, 3, 25, 0, 0, 
+ 96, 112, -127, 21, 3, 
+ 3, 2, 9, 4, 9, 
+ 0, 9, 5, 10, 0, 
+ 6, 6, 1, 0, 9, 
+ 7, 5, 0, 6, 8, 
+ 3, 0, 9, 9, 4, 
+ 0, 9, 10, 2, 0, 
+ 9, 11, 3, 0, 21, 
+ 4, 8, 1, 9, 4, 
+ 0, 0, 26, 4, 13, 
+ 0, 9, 4, 1, 0, 
+ 26, 4, 11, 0, 12, 
+ 4, 32, 0, 0, 124, 
+ 32, -128, 9, 5, 5, 
+ 0, 21, 4, 2, 2, 
+ 80, 4, 6, 0, 33, 
+ 0, 0, -128, 9, 4, 
+ 11, 0, 9, 5, 10, 
+ 0, 5, 6, 34, 0, 
+ 6, 7, 1, 0, 21, 
+ 4, 4, 1, 22, 0, 
+ 1, 0, 35, 3, 2, 
+ 4, 0, 0, 0, 64, 
+ 3, 3, 3, 35, 3, 
+ 5, 4, 0, 0, 64, 
+ 64, 3, 36, 3, 37, 
+ 3, 38, 3, 39, 3, 
+ 40, 3, 41, 3, 11, 
+ 4, 0, 0, -64, 64, 
+ 3, 42, 3, 43, 3, 
+ 6, 3, 44, 3, 45, 
+ 3, 46, 3, 24, 3, 
+ 47, 2, 0, 0, 0, 
+ 0, 0, 0, -16, 63, 
+ 3, 30, 3, 31, 4, 
+ 0, 96, 112, -127, 2, 
  0, 0, 0, 0, 0, 
+ 0, 0, 64, 3, 48, 
+ 3, 49, 3, 50, 2, 
  0, 0, 0, 0, 0, 
- 0, 1, 0, 0, 0, 
- 0, 1, 0, 0, 0, 
+ 0, 0, 0, 3, 51, 
+ 4, 0, 124, 32, -128, 
+ 3, 52, 3, 53, 0, 
+ -3, 1, 54, 1, 24, 
+ 0, 0, 1, 0, 1, 
+ 0, 1, 0, 1, 0, 
+ 1, 0, 2, 0, 1, 
  0, 0, 0, 0, 0, 
- 0, 0, 1, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 0, 0, 2, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 0, 0, 1, 0, 
  1, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
+ 0, 2, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 1, 2, 0, 1, 1, 
- 0, 1, 0, 0, 0, 
+ 0, 1, 0, 1, 0, 
  0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 3, 0, 1, 1, 
- 0, 1, 0, 0, 0, 
+ 0, 0, 0, 1, 2, 
+ 0, 1, 1, 0, 1, 
  0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 3, 0, 0, 1, 
- 0, 2, 0, 0, 0, 
+ 0, 0, 0, 0, 3, 
+ 0, 1, 1, 0, 1, 
  0, 0, 0, 0, 0, 
- 0, 1, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 2, 0, 0, 0, 
+ 0, 0, 0, 0, 3, 
+ 0, 0, 1, 0, 2, 
  0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 1, 
  0, 0, 0, 0, 0, 
- 0, 1, 0, 0, 0, 
- 0, 2, 0, 0, 1, 
+ 0, 0, 0, 0, 2, 
  0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 0, 0, 4, 0, 
- 0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 0, 2, 
+ 0, 0, 1, 0, 0, 
  0, 0, 0, 0, 0, 
- -2, 0, 0, 5, 0, 
- 0, 0, 0, 0, 0, 
- 0, 0, 1, -106, 0, 
- 0, 0, 0, 34, 0, 
- 0, 1, -70, 2, 65, 
- 0, 0, 0, 63, 0, 
- 2, 0, 15, 1, 0, 
- 7, 0, 0, 0, 0, 
- 15, 2, 0, -71, 1, 
- 0, 0, 0, 15, 3, 
- 0, -77, 2, 0, 0, 
- 0, 12, 4, 5, 0, 
- 0, 16, 48, -128, 21, 
- 4, 1, 3, 54, 6, 
- 10, 0, 5, 7, 11, 
- 0, 16, 7, 6, 90, 
- 6, 0, 0, 0, 5, 
- 7, 12, 0, 16, 7, 
- 6, 31, 7, 0, 0, 
- 0, 5, 7, 13, 0, 
- 16, 7, 6, -76, 8, 
- 0, 0, 0, 3, 7, 
- 0, 0, 16, 7, 6, 
- -100, 9, 0, 0, 0, 
- 12, 8, 15, 0, 0, 
- 0, -32, 64, 75, 1, 
- 8, 4, 16, 0, 0, 
- 0, 5, 9, 16, 0, 
- 12, 7, 18, 0, 0, 
- 0, 16, 65, 21, 7, 
- 3, 1, 6, 7, 6, 
- 0, 2, 8, 0, 0, 
- 2, 9, 0, 0, 76, 
- 7, 33, 0, 12, 13, 
- 15, 0, 0, 0, -32, 
- 64, 13, 12, 13, 10, 
- 25, 12, 1, 0, 13, 
- 12, 6, 10, 6, 11, 
- 12, 0, 73, 40, 11, 
- 3, 6, 15, 11, 0, 
- 12, 14, 20, 0, 0, 
- 0, 48, 65, 21, 14, 
- 2, 2, 13, 16, 6, 
- 10, 73, 40, 16, 2, 
- 12, 15, 20, 0, 0, 
- 0, 48, 65, 21, 15, 
- 2, 2, 27, 14, 2, 
- 0, 15, 0, 0, 0, 
- 3, 13, 0, 1, 3, 
- 13, 1, 0, 5, 15, 
- 21, 0, 6, 16, 10, 
- 0, 49, 14, 15, 16, 
- 74, 1, 13, 3, 14, 
- 0, 0, 0, 12, 12, 
- 18, 0, 0, 0, 16, 
- 65, 21, 12, 3, 1, 
- 6, 12, 2, 0, 6, 
- 13, 1, 0, 6, 14, 
- 10, 0, 6, 15, 11, 
- 0, 21, 12, 4, 1, 
- 58, 7, -34, -1, 2, 
- 0, 0, 0, 12, 7, 
- 23, 0, 0, 88, -32, 
- -128, 8, 7, 0, -105, 
- 24, 0, 0, 0, 7, 
- 10, 0, -105, 24, 0, 
- 0, 0, 73, 40, 10, 
- 2, 12, 9, 20, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 4, 0, 0, 0, 
+ 0, 1, 0, 0, 0, 
+ 0, 0, 0, -2, 0, 
+ 0, 5, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 3, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 1, 0, 0, 0, 0, 
+ 2, -2, 0, 0, 0, 
+ 0, 39, 0, 0, 1, 
+ -109, 6, 65, 0, 0, 
+ 0, 63, 0, 2, 0, 
+ 15, 1, 0, 7, 0, 
+ 0, 0, 0, 15, 2, 
+ 0, -71, 1, 0, 0, 
+ 0, 15, 3, 0, -77, 
+ 2, 0, 0, 0, 15, 
+ 4, 0, 95, 3, 0, 
+ 0, 0, 12, 5, 6, 
+ 0, 0, 20, 64, -128, 
+ 21, 5, 1, 3, 54, 
+ 7, 12, 0, 5, 8, 
+ 13, 0, 16, 8, 7, 
+ 90, 7, 0, 0, 0, 
+ 5, 8, 14, 0, 16, 
+ 8, 7, 31, 8, 0, 
+ 0, 0, 5, 8, 15, 
+ 0, 16, 8, 7, -76, 
+ 9, 0, 0, 0, 3, 
+ 8, 0, 0, 16, 8, 
+ 7, -100, 10, 0, 0, 
+ 0, 3, 8, 0, 0, 
+ 16, 8, 7, -9, 11, 
+ 0, 0, 0, 12, 9, 
+ 17, 0, 0, 0, 0, 
+ 65, 75, 1, 9, 4, 
+ 18, 0, 0, 0, 5, 
+ 10, 18, 0, 12, 8, 
+ 20, 0, 0, 0, 48, 
+ 65, 21, 8, 3, 1, 
+ 6, 8, 7, 0, 2, 
+ 9, 0, 0, 2, 10, 
+ 0, 0, 76, 8, 33, 
+ 0, 12, 14, 17, 0, 
+ 0, 0, 0, 65, 13, 
+ 13, 14, 11, 25, 13, 
+ 1, 0, 13, 13, 7, 
+ 11, 6, 12, 13, 0, 
+ 73, 40, 12, 3, 6, 
+ 16, 12, 0, 12, 15, 
+ 22, 0, 0, 0, 80, 
+ 65, 21, 15, 2, 2, 
+ 13, 17, 7, 11, 73, 
+ 40, 17, 2, 12, 16, 
+ 22, 0, 0, 0, 80, 
+ 65, 21, 16, 2, 2, 
+ 27, 15, 2, 0, 16, 
+ 0, 0, 0, 3, 14, 
+ 0, 1, 3, 14, 1, 
+ 0, 5, 16, 23, 0, 
+ 6, 17, 11, 0, 49, 
+ 15, 16, 17, 74, 1, 
+ 14, 3, 15, 0, 0, 
+ 0, 12, 13, 20, 0, 
+ 0, 0, 48, 65, 21, 
+ 13, 3, 1, 6, 13, 
+ 2, 0, 6, 14, 1, 
+ 0, 6, 15, 11, 0, 
+ 6, 16, 12, 0, 21, 
+ 13, 4, 1, 58, 8, 
+ -34, -1, 2, 0, 0, 
+ 0, 12, 8, 25, 0, 
+ 0, 96, 0, -127, 8, 
+ 8, 0, -105, 26, 0, 
+ 0, 0, 7, 11, 0, 
+ -105, 26, 0, 0, 0, 
+ 73, 40, 11, 2, 12, 
+ 10, 22, 0, 0, 0, 
+ 80, 65, 21, 10, 2, 
+ 2, 80, 10, 2, 0, 
+ 27, 0, 0, 0, 3, 
+ 9, 0, 1, 3, 9, 
+ 1, 0, 75, 1, 9, 
+ 4, 28, 0, 0, 0, 
+ 5, 10, 28, 0, 12, 
+ 8, 20, 0, 0, 0, 
+ 48, 65, 21, 8, 3, 
+ 1, 7, 10, 0, -105, 
+ 26, 0, 0, 0, 5, 
+ 12, 29, 0, 20, 10, 
+ 10, 86, 30, 0, 0, 
+ 0, 21, 10, 3, 2, 
+ 50, 9, 10, 0, 75, 
+ 1, 9, 4, 31, 0, 
+ 0, 0, 5, 10, 31, 
+ 0, 12, 8, 20, 0, 
  0, 0, 48, 65, 21, 
+ 8, 3, 1, 6, 8, 
+ 2, 0, 6, 9, 1, 
+ 0, 5, 10, 24, 0, 
+ 7, 11, 0, -105, 26, 
+ 0, 0, 0, 21, 8, 
+ 4, 1, 12, 8, 33, 
+ 0, 0, -128, 0, -127, 
+ 8, 8, 0, -105, 26, 
+ 0, 0, 0, 7, 8, 
+ 0, -105, 26, 0, 0, 
+ 0, 77, 8, 39, 0, 
+ 0, 0, 0, 0, 7, 
+ 9, 0, -105, 26, 0, 
+ 0, 0, 73, 40, 9, 
+ 2, 12, 8, 22, 0, 
+ 0, 0, 80, 65, 21, 
+ 8, 2, 2, 80, 8, 
+ 21, 0, 34, 0, 0, 
+ -128, 7, 8, 0, -105, 
+ 26, 0, 0, 0, 4, 
+ 9, 1, 0, 29, 8, 
+ 16, 0, 9, 0, 0, 
+ 0, 7, 8, 0, -105, 
+ 26, 0, 0, 0, 5, 
+ 9, 35, 0, 29, 9, 
+ 11, 0, 8, 0, 0, 
+ 0, 7, 9, 0, -105, 
+ 26, 0, 0, 0, 73, 
+ 12, 9, 2, 12, 8, 
+ 38, 0, 0, -108, 64, 
+ -126, 21, 8, 2, 2, 
+ 7, 9, 0, -105, 26, 
+ 0, 0, 0, 27, 8, 
+ 5, 0, 9, 0, 0, 
+ 0, 12, 8, 40, 0, 
+ 0, 0, 112, 66, 5, 
+ 9, 41, 0, 21, 8, 
+ 2, 1, 6, 8, 2, 
+ 0, 6, 9, 1, 0, 
+ 5, 10, 32, 0, 7, 
+ 11, 0, -105, 26, 0, 
+ 0, 0, 21, 8, 4, 
+ 1, 12, 9, 43, 0, 
+ 0, -88, 0, -127, 34, 
+ 8, 9, 5, 8, 8, 
+ 0, -105, 26, 0, 0, 
+ 0, 7, 8, 0, -105, 
+ 26, 0, 0, 0, 79, 
+ 8, 16, 0, 44, 0, 
+ 0, 0, 12, 8, 40, 
+ 0, 0, 0, 112, 66, 
+ 12, 9, 46, 0, 0, 
+ -76, -80, -127, 5, 10, 
+ 47, 0, 7, 12, 0, 
+ -105, 26, 0, 0, 0, 
+ 4, 13, 0, 0, 32, 
+ 13, 3, 0, 12, 0, 
+ 0, 0, 5, 11, 48, 
+ 0, 23, 0, 1, 0, 
+ 5, 11, 49, 0, 21, 
+ 9, 3, 0, 21, 8, 
+ 0, 1, 12, 8, 51, 
+ 0, 0, -56, 0, -127, 
+ 32, 6, 5, 0, 8, 
+ 0, 0, 0, 12, 8, 
+ 40, 0, 0, 0, 112, 
+ 66, 5, 9, 52, 0, 
+ 21, 8, 2, 1, 12, 
+ 9, 55, 0, 0, -40, 
+ 0, -127, 48, 8, 9, 
+ 53, 8, 8, 0, -105, 
+ 26, 0, 0, 0, 7, 
+ 8, 0, -105, 26, 0, 
+ 0, 0, 79, 8, 17, 
+ 0, 53, 0, 0, 0, 
+ 7, 8, 0, -105, 26, 
+ 0, 0, 0, 79, 8, 
+ 13, 0, 56, 0, 0, 
+ 0, 7, 8, 0, -105, 
+ 26, 0, 0, 0, 79, 
+ 8, 9, 0, 57, 0, 
+ 0, 0, 7, 8, 0, 
+ -105, 26, 0, 0, 0, 
+ 79, 8, 5, 0, 58, 
+ 0, 0, 0, 12, 8, 
+ 40, 0, 0, 0, 112, 
+ 66, 5, 9, 59, 0, 
+ 21, 8, 2, 1, 6, 
+ 8, 2, 0, 6, 9, 
+ 1, 0, 5, 10, 54, 
+ 0, 7, 11, 0, -105, 
+ 26, 0, 0, 0, 21, 
+ 8, 4, 1, 12, 8, 
+ 61, 0, 0, -16, 0, 
+ -127, 8, 8, 0, -105, 
+ 26, 0, 0, 0, 7, 
+ 8, 0, -105, 26, 0, 
+ 0, 0, 78, 8, 4, 
+ 0, 1, 0, 0, -128, 
+ 4, 8, 0, 4, 8, 
+ 8, 0, -105, 26, 0, 
+ 0, 0, 7, 8, 0, 
+ -105, 26, 0, 0, 0, 
+ 26, 8, 45, 0, 7, 
+ 9, 0, -105, 26, 0, 
+ 0, 0, 73, 40, 9, 
+ 2, 12, 8, 22, 0, 
+ 0, 0, 80, 65, 21, 
+ 8, 2, 2, 80, 8, 
+ 21, 0, 34, 0, 0, 
+ -128, 7, 8, 0, -105, 
+ 26, 0, 0, 0, 4, 
+ 9, 32, 0, 29, 8, 
+ 16, 0, 9, 0, 0, 
+ 0, 7, 8, 0, -105, 
+ 26, 0, 0, 0, 5, 
+ 9, 62, 0, 29, 9, 
+ 11, 0, 8, 0, 0, 
+ 0, 7, 9, 0, -105, 
+ 26, 0, 0, 0, 73, 
+ 12, 9, 2, 12, 8, 
+ 38, 0, 0, -108, 64, 
+ -126, 21, 8, 2, 2, 
+ 7, 9, 0, -105, 26, 
+ 0, 0, 0, 27, 8, 
+ 5, 0, 9, 0, 0, 
+ 0, 12, 8, 40, 0, 
+ 0, 0, 112, 66, 5, 
+ 9, 63, 0, 21, 8, 
+ 2, 1, 12, 8, 64, 
+ 0, 0, 40, 0, -127, 
+ 26, 8, 4, 0, 12, 
+ 8, 40, 0, 0, 0, 
+ 112, 66, 5, 9, 65, 
+ 0, 21, 8, 2, 1, 
+ 6, 8, 2, 0, 6, 
+ 9, 1, 0, 5, 10, 
+ 60, 0, 7, 11, 0, 
+ -105, 26, 0, 0, 0, 
+ 21, 8, 4, 1, 12, 
+ 8, 67, 0, 0, 8, 
+ 1, -127, 8, 8, 0, 
+ -105, 26, 0, 0, 0, 
+ 7, 8, 0, -105, 26, 
+ 0, 0, 0, 77, 8, 
+ 4, 0, 0, 0, 0, 
+ -128, 3, 8, 1, 0, 
+ 8, 8, 0, -105, 26, 
+ 0, 0, 0, 7, 11, 
+ 0, -105, 26, 0, 0, 
+ 0, 73, 40, 11, 2, 
+ 12, 10, 22, 0, 0, 
+ 0, 80, 65, 21, 10, 
+ 2, 2, 80, 10, 2, 
+ 0, 68, 0, 0, 0, 
+ 3, 9, 0, 1, 3, 
+ 9, 1, 0, 75, 1, 
+ 9, 4, 69, 0, 0, 
+ 0, 5, 10, 69, 0, 
+ 12, 8, 20, 0, 0, 
+ 0, 48, 65, 21, 8, 
+ 3, 1, 6, 8, 2, 
+ 0, 6, 9, 1, 0, 
+ 5, 10, 66, 0, 7, 
+ 11, 0, -105, 26, 0, 
+ 0, 0, 21, 8, 4, 
+ 1, 54, 8, 73, 0, 
+ 4, 9, 1, 0, 16, 
+ 9, 8, 26, 70, 0, 
+ 0, 0, 4, 9, 2, 
+ 0, 16, 9, 8, -127, 
+ 71, 0, 0, 0, 4, 
+ 9, 3, 0, 16, 9, 
+ 8, 55, 72, 0, 0, 
+ 0, 12, 9, 75, 0, 
+ 0, 40, 1, -127, 8, 
+ 9, 0, -105, 26, 0, 
+ 0, 0, 7, 9, 0, 
+ -105, 26, 0, 0, 0, 
+ 78, 9, 4, 0, 1, 
+ 0, 0, -128, 5, 9, 
+ 71, 0, 8, 9, 0, 
+ -105, 26, 0, 0, 0, 
+ 7, 9, 0, -105, 26, 
+ 0, 0, 0, 26, 9, 
+ 15, 0, 7, 10, 0, 
+ -105, 26, 0, 0, 0, 
+ 13, 9, 8, 10, 25, 
+ 9, 4, 0, 12, 9, 
+ 40, 0, 0, 0, 112, 
+ 66, 5, 10, 76, 0, 
+ 21, 9, 2, 1, 6, 
+ 9, 2, 0, 6, 10, 
+ 1, 0, 5, 11, 74, 
+ 0, 7, 13, 0, -105, 
+ 26, 0, 0, 0, 13, 
+ 12, 8, 13, 21, 9, 
+ 4, 1, 12, 10, 79, 
+ 0, 0, 56, 1, -127, 
+ 48, 9, 10, 77, 8, 
+ 9, 0, -105, 26, 0, 
+ 0, 0, 7, 10, 0, 
+ -105, 26, 0, 0, 0, 
+ 73, 40, 10, 2, 12, 
+ 9, 22, 0, 0, 0, 
+ 80, 65, 21, 9, 2, 
+ 2, 80, 9, 16, 0, 
+ 34, 0, 0, -128, 7, 
+ 9, 0, -105, 26, 0, 
+ 0, 0, 4, 10, 0, 
+ 0, 29, 9, 11, 0, 
+ 10, 0, 0, 0, 7, 
+ 10, 0, -105, 26, 0, 
+ 0, 0, 73, 12, 10, 
+ 2, 12, 9, 38, 0, 
+ 0, -108, 64, -126, 21, 
+ 9, 2, 2, 7, 10, 
+ 0, -105, 26, 0, 0, 
+ 0, 27, 9, 5, 0, 
+ 10, 0, 0, 0, 12, 
+ 9, 40, 0, 0, 0, 
+ 112, 66, 5, 10, 80, 
+ 0, 21, 9, 2, 1, 
+ 6, 9, 2, 0, 6, 
+ 10, 1, 0, 5, 11, 
+ 78, 0, 7, 12, 0, 
+ -105, 26, 0, 0, 0, 
+ 21, 9, 4, 1, 12, 
+ 10, 82, 0, 0, 68, 
+ 1, -127, 48, 9, 10, 
+ 56, 8, 9, 0, -105, 
+ 26, 0, 0, 0, 7, 
+ 10, 0, -105, 26, 0, 
+ 0, 0, 73, 40, 10, 
+ 2, 12, 9, 22, 0, 
+ 0, 0, 80, 65, 21, 
  9, 2, 2, 80, 9, 
- 2, 0, 25, 0, 0, 
- 0, 3, 8, 0, 1, 
- 3, 8, 1, 0, 75, 
- 1, 8, 4, 26, 0, 
- 0, 0, 5, 9, 26, 
- 0, 12, 7, 18, 0, 
- 0, 0, 16, 65, 21, 
- 7, 3, 1, 6, 7, 
- 2, 0, 6, 8, 1, 
- 0, 5, 9, 22, 0, 
- 7, 10, 0, -105, 24, 
- 0, 0, 0, 21, 7, 
- 4, 1, 12, 8, 28, 
- 0, 0, 108, -32, -128, 
- 34, 7, 8, 4, 8, 
- 7, 0, -105, 24, 0, 
- 0, 0, 7, 7, 0, 
- -105, 24, 0, 0, 0, 
- 79, 7, 16, 0, 29, 
- 0, 0, 0, 12, 7, 
- 31, 0, 0, 0, -32, 
- 65, 12, 8, 33, 0, 
- 0, -128, -112, -127, 5, 
- 9, 34, 0, 7, 11, 
- 0, -105, 24, 0, 0, 
- 0, 4, 12, 0, 0, 
- 32, 12, 3, 0, 11, 
- 0, 0, 0, 5, 10, 
- 35, 0, 23, 0, 1, 
- 0, 5, 10, 36, 0, 
- 21, 8, 3, 0, 21, 
- 7, 0, 1, 12, 7, 
- 38, 0, 0, -108, -32, 
- -128, 32, 5, 5, 0, 
- 7, 0, 0, 0, 12, 
- 7, 31, 0, 0, 0, 
- -32, 65, 5, 8, 39, 
- 0, 21, 7, 2, 1, 
- 12, 8, 41, 0, 0, 
- 0, -128, 66, 75, 1, 
- 8, 4, 42, 0, 0, 
- 0, 5, 9, 42, 0, 
- 12, 7, 18, 0, 0, 
- 0, 16, 65, 21, 7, 
- 3, 1, 12, 8, 41, 
- 0, 0, 0, -128, 66, 
- 52, 7, 8, 0, 8, 
- 7, 0, -105, 24, 0, 
- 0, 0, 7, 7, 0, 
- -105, 24, 0, 0, 0, 
- 4, 8, 0, 0, 31, 
- 7, 5, 0, 8, 0, 
- 0, 0, 12, 7, 31, 
- 0, 0, 0, -32, 65, 
- 5, 8, 43, 0, 21, 
- 7, 2, 1, 6, 7, 
- 2, 0, 6, 8, 1, 
- 0, 5, 9, 44, 0, 
- 7, 10, 0, -105, 24, 
- 0, 0, 0, 21, 7, 
- 4, 1, 54, 7, 50, 
- 0, 4, 8, 64, 0, 
- 16, 8, 7, -72, 45, 
- 0, 0, 0, 4, 8, 
- -128, 0, 16, 8, 7, 
- -104, 46, 0, 0, 0, 
- 4, 8, -64, 0, 16, 
- 8, 7, 110, 47, 0, 
- 0, 0, 4, 8, 0, 
- 1, 16, 8, 7, -59, 
- 48, 0, 0, 0, 4, 
- 8, 64, 1, 16, 8, 
- 7, -108, 49, 0, 0, 
- 0, 53, 8, 0, 0, 
- 5, 0, 0, 0, 4, 
- 9, 64, 0, 4, 10, 
- -128, 0, 4, 11, -64, 
- 0, 4, 12, 0, 1, 
- 4, 13, 64, 1, 55, 
- 8, 9, 6, 1, 0, 
- 0, 0, 64, 9, 51, 
- 0, 64, 10, 52, 0, 
- 70, 0, 7, 0, 70, 
- 0, 9, 0, 70, 0, 
- 8, 0, 2, 11, 0, 
- 0, 2, 12, 0, 0, 
- 2, 13, 0, 0, 2, 
- 14, 0, 0, 2, 15, 
- 0, 0, 2, 16, 0, 
- 0, 19, 17, 2, 0, 
- 70, 1, 11, 0, 70, 
- 1, 12, 0, 19, 18, 
- 3, 0, 70, 1, 15, 
- 0, 70, 1, 13, 0, 
- 70, 1, 14, 0, 19, 
- 19, 4, 0, 70, 1, 
- 11, 0, 70, 1, 12, 
- 0, 70, 1, 13, 0, 
- 70, 1, 14, 0, 70, 
+ 21, 0, 34, 0, 0, 
+ -128, 7, 9, 0, -105, 
+ 26, 0, 0, 0, 4, 
+ 10, 0, 0, 29, 9, 
+ 16, 0, 10, 0, 0, 
+ 0, 7, 9, 0, -105, 
+ 26, 0, 0, 0, 4, 
+ 10, 64, 0, 29, 10, 
+ 11, 0, 9, 0, 0, 
+ 0, 7, 10, 0, -105, 
+ 26, 0, 0, 0, 73, 
+ 12, 10, 2, 12, 9, 
+ 38, 0, 0, -108, 64, 
+ -126, 21, 9, 2, 2, 
+ 7, 10, 0, -105, 26, 
+ 0, 0, 0, 27, 9, 
+ 5, 0, 10, 0, 0, 
+ 0, 12, 9, 40, 0, 
+ 0, 0, 112, 66, 5, 
+ 10, 83, 0, 21, 9, 
+ 2, 1, 6, 9, 2, 
+ 0, 6, 10, 1, 0, 
+ 5, 11, 84, 0, 7, 
+ 12, 0, -105, 26, 0, 
+ 0, 0, 21, 9, 4, 
+ 1, 12, 9, 86, 0, 
+ 0, 84, 1, -127, 8, 
+ 9, 0, -105, 26, 0, 
+ 0, 0, 7, 9, 0, 
+ -105, 26, 0, 0, 0, 
+ 77, 9, 4, 0, 0, 
+ 0, 0, -128, 3, 9, 
+ 0, 0, 8, 9, 0, 
+ -105, 26, 0, 0, 0, 
+ 7, 12, 0, -105, 26, 
+ 0, 0, 0, 73, 40, 
+ 12, 2, 12, 11, 22, 
+ 0, 0, 0, 80, 65, 
+ 21, 11, 2, 2, 80, 
+ 11, 2, 0, 68, 0, 
+ 0, 0, 3, 10, 0, 
+ 1, 3, 10, 1, 0, 
+ 75, 1, 10, 4, 87, 
+ 0, 0, 0, 5, 11, 
+ 87, 0, 12, 9, 20, 
+ 0, 0, 0, 48, 65, 
+ 21, 9, 3, 1, 6, 
+ 9, 2, 0, 6, 10, 
+ 1, 0, 5, 11, 85, 
+ 0, 7, 12, 0, -105, 
+ 26, 0, 0, 0, 21, 
+ 9, 4, 1, 7, 10, 
+ 0, 52, 88, 0, 0, 
+ 0, 75, 1, 10, 4, 
+ 89, 0, 0, 0, 5, 
+ 11, 89, 0, 12, 9, 
+ 20, 0, 0, 0, 48, 
+ 65, 21, 9, 3, 1, 
+ 53, 9, 0, 0, 0, 
+ 0, 0, 0, 53, 10, 
+ 0, 0, 0, 0, 0, 
+ 0, 2, 11, 0, 0, 
+ 4, 14, 1, 0, 7, 
+ 15, 0, 52, 88, 0, 
+ 0, 0, 52, 12, 15, 
+ 0, 4, 13, 1, 0, 
+ 56, 12, 116, 0, 7, 
+ 16, 0, 52, 88, 0, 
+ 0, 0, 13, 15, 16, 
+ 14, 73, 40, 15, 3, 
+ 6, 19, 15, 0, 12, 
+ 18, 22, 0, 0, 0, 
+ 80, 65, 21, 18, 2, 
+ 2, 80, 18, 2, 0, 
+ 90, 0, 0, 0, 3, 
+ 17, 0, 1, 3, 17, 
+ 1, 0, 75, 1, 17, 
+ 4, 91, 0, 0, 0, 
+ 5, 18, 91, 0, 12, 
+ 16, 20, 0, 0, 0, 
+ 48, 65, 21, 16, 3, 
+ 1, 15, 16, 15, 99, 
+ 92, 0, 0, 0, 77, 
+ 16, 5, 0, 0, 0, 
+ 0, -128, 52, 18, 9, 
+ 0, 39, 17, 18, 53, 
+ 14, 15, 9, 17, 23, 
+ 0, 89, 0, 73, 40, 
+ 16, 3, 6, 18, 16, 
+ 0, 12, 17, 22, 0, 
+ 0, 0, 80, 65, 21, 
+ 17, 2, 2, 80, 17, 
+ 14, 0, 34, 0, 0, 
+ -128, 4, 17, 1, 0, 
+ 29, 16, 11, 0, 17, 
+ 0, 0, 0, 4, 17, 
+ 64, 0, 29, 17, 8, 
+ 0, 16, 0, 0, 0, 
+ 73, 12, 16, 3, 6, 
+ 18, 16, 0, 12, 17, 
+ 38, 0, 0, -108, 64, 
+ -126, 21, 17, 2, 2, 
+ 27, 17, 12, 0, 16, 
+ 0, 0, 0, 12, 17, 
+ 40, 0, 0, 0, 112, 
+ 66, 5, 19, 93, 0, 
+ 12, 22, 95, 0, 0, 
+ 0, -32, 69, 6, 23, 
+ 14, 0, 21, 22, 2, 
+ 2, 6, 20, 22, 0, 
+ 5, 21, 96, 0, 49, 
+ 18, 19, 21, 21, 17, 
+ 2, 1, 26, 11, 6, 
+ 0, 27, 11, 5, 0, 
+ 16, 0, 0, 0, 12, 
+ 17, 40, 0, 0, 0, 
+ 112, 66, 5, 18, 97, 
+ 0, 21, 17, 2, 1, 
+ 6, 11, 16, 0, 15, 
+ 17, 15, 90, 7, 0, 
+ 0, 0, 25, 17, 6, 
+ 0, 5, 18, 98, 0, 
+ 12, 19, 95, 0, 0, 
+ 0, -32, 69, 6, 20, 
+ 14, 0, 21, 19, 2, 
+ 2, 49, 17, 18, 19, 
+ 73, 40, 17, 3, 6, 
+ 21, 17, 0, 12, 20, 
+ 22, 0, 0, 0, 80, 
+ 65, 21, 20, 2, 2, 
+ 80, 20, 2, 0, 27, 
+ 0, 0, 0, 3, 19, 
+ 0, 1, 3, 19, 1, 
+ 0, 75, 1, 19, 4, 
+ 99, 0, 0, 0, 5, 
+ 20, 99, 0, 12, 18, 
+ 20, 0, 0, 0, 48, 
+ 65, 21, 18, 3, 1, 
+ 4, 20, 1, 0, 6, 
+ 18, 16, 0, 4, 19, 
+ 1, 0, 56, 18, 22, 
+ 0, 12, 21, 101, 0, 
+ 0, -112, -95, -123, 6, 
+ 22, 15, 0, 21, 21, 
+ 2, 2, 6, 23, 17, 
+ 0, 5, 24, 102, 0, 
+ 12, 25, 95, 0, 0, 
+ 0, -32, 69, 6, 26, 
+ 20, 0, 21, 25, 2, 
+ 2, 49, 22, 23, 25, 
+ 16, 22, 21, 90, 7, 
+ 0, 0, 0, 2, 22, 
+ 0, 0, 16, 22, 21, 
+ 99, 92, 0, 0, 0, 
+ 52, 23, 9, 0, 39, 
+ 22, 23, 53, 14, 21, 
+ 9, 22, 52, 22, 9, 
+ 0, 14, 20, 10, 22, 
+ 57, 18, -22, -1, 57, 
+ 12, -116, -1, 8, 9, 
+ 0, 52, 88, 0, 0, 
+ 0, 7, 13, 0, 52, 
+ 88, 0, 0, 0, 52, 
+ 12, 13, 0, 8, 12, 
+ 0, -105, 26, 0, 0, 
+ 0, 7, 12, 0, -105, 
+ 26, 0, 0, 0, 4, 
+ 13, 0, 0, 31, 12, 
+ 5, 0, 13, 0, 0, 
+ 0, 12, 12, 40, 0, 
+ 0, 0, 112, 66, 5, 
+ 13, 103, 0, 21, 12, 
+ 2, 1, 6, 12, 2, 
+ 0, 6, 13, 1, 0, 
+ 5, 14, 104, 0, 7, 
+ 15, 0, -105, 26, 0, 
+ 0, 0, 21, 12, 4, 
+ 1, 6, 12, 2, 0, 
+ 6, 13, 1, 0, 5, 
+ 14, 92, 0, 48, 15, 
+ 11, 44, 21, 12, 4, 
+ 1, 54, 12, 110, 0, 
+ 4, 13, 64, 0, 16, 
+ 13, 12, -72, 105, 0, 
+ 0, 0, 4, 13, -128, 
+ 0, 16, 13, 12, -104, 
+ 106, 0, 0, 0, 4, 
+ 13, -64, 0, 16, 13, 
+ 12, 110, 107, 0, 0, 
+ 0, 4, 13, 0, 1, 
+ 16, 13, 12, -59, 108, 
+ 0, 0, 0, 4, 13, 
+ 64, 1, 16, 13, 12, 
+ -108, 109, 0, 0, 0, 
+ 53, 13, 0, 0, 5, 
+ 0, 0, 0, 4, 14, 
+ 64, 0, 4, 15, -128, 
+ 0, 4, 16, -64, 0, 
+ 4, 17, 0, 1, 4, 
+ 18, 64, 1, 55, 13, 
+ 14, 6, 1, 0, 0, 
+ 0, 64, 14, 111, 0, 
+ 64, 15, 112, 0, 70, 
+ 0, 12, 0, 70, 0, 
+ 14, 0, 70, 0, 13, 
+ 0, 2, 16, 0, 0, 
+ 2, 17, 0, 0, 2, 
+ 18, 0, 0, 2, 19, 
+ 0, 0, 2, 20, 0, 
+ 0, 2, 21, 0, 0, 
+ 19, 22, 2, 0, 70, 
+ 1, 16, 0, 70, 1, 
+ 17, 0, 19, 23, 3, 
+ 0, 70, 1, 20, 0, 
+ 70, 1, 18, 0, 70, 
+ 1, 19, 0, 19, 24, 
+ 4, 0, 70, 1, 16, 
+ 0, 70, 1, 17, 0, 
+ 70, 1, 18, 0, 70, 
+ 1, 19, 0, 70, 1, 
+ 20, 0, 70, 1, 21, 
+ 0, 70, 1, 22, 0, 
+ 70, 1, 23, 0, 70, 
  1, 15, 0, 70, 1, 
- 16, 0, 70, 1, 17, 
- 0, 70, 1, 18, 0, 
- 70, 1, 10, 0, 70, 
- 1, 3, 0, 70, 1, 
- 1, 0, 4, 22, 1, 
- 0, 12, 23, 41, 0, 
- 0, 0, -128, 66, 52, 
- 20, 23, 0, 4, 21, 
- 1, 0, 56, 20, 38, 
- 0, 12, 24, 41, 0, 
- 0, 0, -128, 66, 13, 
- 23, 24, 22, 73, 40, 
- 23, 3, 6, 27, 23, 
- 0, 12, 26, 20, 0, 
- 0, 0, 48, 65, 21, 
- 26, 2, 2, 80, 26, 
- 2, 0, 53, 0, 0, 
- 0, 3, 25, 0, 1, 
- 3, 25, 1, 0, 75, 
- 1, 25, 4, 54, 0, 
- 0, 0, 5, 26, 54, 
- 0, 12, 24, 18, 0, 
- 0, 0, 16, 65, 21, 
- 24, 3, 1, 12, 24, 
- 56, 0, 0, 0, 112, 
- 67, 6, 25, 19, 0, 
- 6, 26, 23, 0, 6, 
- 27, 22, 0, 21, 24, 
- 4, 3, 25, 24, 12, 
- 0, 12, 26, 31, 0, 
- 0, 0, -32, 65, 6, 
- 28, 25, 0, 5, 29, 
- 57, 0, 12, 32, 59, 
- 0, 0, 0, -96, 67, 
- 6, 33, 22, 0, 21, 
- 32, 2, 2, 6, 30, 
- 32, 0, 5, 31, 60, 
- 0, 49, 27, 28, 31, 
- 21, 26, 2, 1, 57, 
- 20, -38, -1, 53, 20, 
- 2, 0, 0, 0, 0, 
- 0, 3, 21, 1, 0, 
- 16, 21, 20, -102, 14, 
- 0, 0, 0, 3, 21, 
- 1, 0, 16, 21, 20, 
- 52, 40, 0, 0, 0, 
- 12, 21, 62, 0, 0, 
- 0, -48, 67, 2, 22, 
- 0, 0, 2, 23, 0, 
- 0, 76, 21, 6, 0, 
- 13, 26, 20, 24, 25, 
- 26, 4, 0, 12, 26, 
- 62, 0, 0, 0, -48, 
- 67, 2, 27, 0, 0, 
- 14, 27, 26, 24, 58, 
- 21, -7, -1, 2, 0, 
- 0, 0, 12, 21, 64, 
- 0, 0, -4, 80, -125, 
- 12, 22, 15, 0, 0, 
- 0, -32, 64, 21, 21, 
- 2, 1, 12, 21, 64, 
- 0, 0, -4, 80, -125, 
- 12, 22, 41, 0, 0, 
- 0, -128, 66, 21, 21, 
- 2, 1, 2, 21, 0, 
- 0, 16, 21, 0, -71, 
- 1, 0, 0, 0, 2, 
- 21, 0, 0, 16, 21, 
- 0, -77, 2, 0, 0, 
- 0, 2, 20, 0, 0, 
- 2, 1, 0, 0, 2, 
- 2, 0, 0, 2, 3, 
- 0, 0, 2, 6, 0, 
- 0, 2, 17, 0, 0, 
- 2, 18, 0, 0, 2, 
- 10, 0, 0, 2, 19, 
- 0, 0, 12, 21, 66, 
- 0, 0, 0, 16, 68, 
- 5, 22, 67, 0, 21, 
- 21, 2, 1, 15, 21, 
- 0, 99, 68, 0, 0, 
- 0, 21, 21, 1, 1, 
- 2, 21, 0, 0, 16, 
- 21, 0, 99, 68, 0, 
+ 3, 0, 70, 1, 1, 
+ 0, 70, 1, 2, 0, 
+ 4, 27, 1, 0, 7, 
+ 28, 0, 52, 88, 0, 
+ 0, 0, 52, 25, 28, 
+ 0, 4, 26, 1, 0, 
+ 56, 25, 30, 0, 7, 
+ 29, 0, 52, 88, 0, 
+ 0, 0, 13, 28, 29, 
+ 27, 12, 29, 114, 0, 
+ 0, 0, 16, 71, 6, 
+ 30, 24, 0, 6, 31, 
+ 28, 0, 6, 32, 27, 
+ 0, 21, 29, 4, 3, 
+ 25, 29, 12, 0, 12, 
+ 31, 40, 0, 0, 0, 
+ 112, 66, 6, 33, 30, 
+ 0, 5, 34, 115, 0, 
+ 12, 37, 95, 0, 0, 
+ 0, -32, 69, 6, 38, 
+ 27, 0, 21, 37, 2, 
+ 2, 6, 35, 37, 0, 
+ 5, 36, 96, 0, 49, 
+ 32, 33, 36, 21, 31, 
+ 2, 1, 13, 31, 10, 
+ 27, 26, 31, 5, 0, 
+ 6, 31, 4, 0, 6, 
+ 32, 1, 0, 6, 33, 
+ 27, 0, 13, 34, 10, 
+ 27, 21, 31, 4, 1, 
+ 57, 25, -30, -1, 53, 
+ 25, 2, 0, 0, 0, 
+ 0, 0, 3, 26, 1, 
+ 0, 16, 26, 25, -102, 
+ 16, 0, 0, 0, 3, 
+ 26, 1, 0, 16, 26, 
+ 25, 52, 88, 0, 0, 
+ 0, 12, 26, 117, 0, 
+ 0, 0, 64, 71, 2, 
+ 27, 0, 0, 2, 28, 
+ 0, 0, 76, 26, 6, 
+ 0, 13, 31, 25, 29, 
+ 25, 31, 4, 0, 12, 
+ 31, 117, 0, 0, 0, 
+ 64, 71, 2, 32, 0, 
+ 0, 14, 32, 31, 29, 
+ 58, 26, -7, -1, 2, 
+ 0, 0, 0, 12, 26, 
+ 119, 0, 0, -40, -95, 
+ -123, 12, 27, 17, 0, 
+ 0, 0, 0, 65, 21, 
+ 26, 2, 1, 12, 26, 
+ 119, 0, 0, -40, -95, 
+ -123, 7, 27, 0, 52, 
+ 88, 0, 0, 0, 21, 
+ 26, 2, 1, 2, 26, 
+ 0, 0, 16, 26, 0, 
+ -71, 1, 0, 0, 0, 
+ 2, 26, 0, 0, 16, 
+ 26, 0, -77, 2, 0, 
+ 0, 0, 2, 26, 0, 
+ 0, 16, 26, 0, 95, 
+ 3, 0, 0, 0, 2, 
+ 25, 0, 0, 2, 1, 
+ 0, 0, 2, 2, 0, 
+ 0, 2, 3, 0, 0, 
+ 2, 4, 0, 0, 2, 
+ 9, 0, 0, 2, 10, 
+ 0, 0, 2, 7, 0, 
+ 0, 2, 22, 0, 0, 
+ 2, 23, 0, 0, 2, 
+ 15, 0, 0, 2, 24, 
+ 0, 0, 12, 26, 121, 
+ 0, 0, 0, -128, 71, 
+ 5, 27, 122, 0, 21, 
+ 26, 2, 1, 15, 26, 
+ 0, 99, 123, 0, 0, 
+ 0, 21, 26, 1, 1, 
+ 2, 26, 0, 0, 16, 
+ 26, 0, 99, 123, 0, 
  0, 0, 11, 1, 0, 
  0, 22, 0, 1, 0, 
- 69, 3, 52, 3, 53, 
- 3, 54, 3, 55, 3, 
- 56, 4, 0, 16, 48, 
- -128, 3, 40, 3, 57, 
- 3, 58, 3, 59, 5, 
- 4, 6, 7, 8, 9, 
- 3, 60, 3, 61, 3, 
- 62, 3, 63, 4, 0, 
- 0, -32, 64, 3, 64, 
+ 124, 3, 55, 3, 56, 
+ 3, 57, 3, 58, 3, 
+ 59, 3, 60, 4, 0, 
+ 20, 64, -128, 3, 40, 
+ 3, 61, 3, 62, 3, 
+ 63, 3, 64, 5, 5, 
+ 7, 8, 9, 10, 11, 
+ 3, 65, 3, 66, 3, 
+ 67, 3, 68, 4, 0, 
+ 0, 0, 65, 3, 69, 
  3, 5, 4, 0, 0, 
- 16, 65, 3, 2, 4, 
- 0, 0, 48, 65, 3, 
- 65, 3, 66, 4, 0, 
- 88, -32, -128, 3, 7, 
- 3, 3, 3, 67, 3, 
- 68, 4, 0, 108, -32, 
- -128, 2, 0, 0, 0, 
- 0, 0, 0, 0, 0, 
- 3, 12, 4, 0, 0, 
- -32, 65, 3, 69, 4, 
- 0, -128, -112, -127, 3, 
- 70, 3, 71, 3, 72, 
- 3, 73, 4, 0, -108, 
- -32, -128, 3, 74, 3, 
- 75, 4, 0, 0, -128, 
- 66, 3, 76, 3, 77, 
- 3, 78, 3, 43, 3, 
- 79, 3, 80, 3, 81, 
- 3, 45, 5, 5, 45, 
- 46, 47, 48, 49, 6, 
- 0, 6, 1, 3, 82, 
- 3, 83, 3, 84, 4, 
- 0, 0, 112, 67, 3, 
- 85, 3, 11, 4, 0, 
- 0, -96, 67, 3, 86, 
- 3, 87, 4, 0, 0, 
- -48, 67, 3, 88, 4, 
- 0, -4, 80, -125, 3, 
- 16, 4, 0, 0, 16, 
- 68, 3, 89, 3, 90, 
- 5, 0, 1, 2, 3, 
- 4, 1, 0, 1, 24, 
- 0, 9, 2, 0, 1, 
+ 48, 65, 3, 2, 4, 
+ 0, 0, 80, 65, 3, 
+ 70, 3, 71, 4, 0, 
+ 96, 0, -127, 3, 7, 
+ 3, 3, 3, 72, 3, 
+ 73, 3, 74, 3, 75, 
+ 3, 76, 4, 0, -128, 
+ 0, -127, 3, 6, 2, 
+ 0, 0, 0, -32, -1, 
+ -1, 111, 65, 3, 8, 
+ 3, 9, 4, 0, -108, 
+ 64, -126, 3, 12, 4, 
+ 0, 0, 112, 66, 3, 
+ 77, 3, 78, 4, 0, 
+ -88, 0, -127, 2, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 3, 79, 4, 
+ 0, -76, -80, -127, 3, 
+ 80, 3, 81, 3, 82, 
+ 3, 83, 4, 0, -56, 
+ 0, -127, 3, 84, 2, 
+ 0, 0, 0, 0, 0, 
+ 0, -16, 63, 3, 85, 
+ 4, 0, -40, 0, -127, 
+ 2, 0, 0, 0, 0, 
+ 0, 0, 0, 64, 2, 
+ 0, 0, 0, 0, 0, 
+ 0, 16, 64, 2, 0, 
+ 0, 0, 0, 0, 0, 
+ 32, 64, 3, 86, 3, 
+ 87, 4, 0, -16, 0, 
+ -127, 2, 0, 0, 0, 
+ 0, 0, 0, -16, 64, 
+ 3, 88, 4, 0, 40, 
+ 0, -127, 3, 89, 3, 
+ 90, 4, 0, 8, 1, 
+ -127, 3, 91, 3, 92, 
+ 3, 93, 3, 29, 3, 
+ 94, 5, 3, 70, 71, 
+ 72, 3, 95, 4, 0, 
+ 40, 1, -127, 3, 96, 
+ 2, 0, 0, 0, 0, 
+ 0, 0, 48, 64, 3, 
+ 97, 4, 0, 56, 1, 
+ -127, 3, 98, 3, 99, 
+ 4, 0, 68, 1, -127, 
+ 3, 100, 3, 101, 3, 
+ 102, 4, 0, 84, 1, 
+ -127, 3, 103, 3, 104, 
+ 3, 105, 3, 106, 3, 
+ 107, 3, 108, 3, 109, 
+ 3, 11, 4, 0, 0, 
+ -32, 69, 3, 110, 3, 
+ 111, 3, 41, 3, 42, 
+ 3, 112, 4, 0, -112, 
+ -95, -123, 3, 113, 3, 
+ 114, 3, 115, 3, 43, 
+ 3, 116, 3, 117, 3, 
+ 118, 3, 45, 5, 5, 
+ 105, 106, 107, 108, 109, 
+ 6, 0, 6, 1, 3, 
+ 119, 4, 0, 0, 16, 
+ 71, 3, 120, 3, 121, 
+ 4, 0, 0, 64, 71, 
+ 3, 122, 4, 0, -40, 
+ -95, -123, 3, 16, 4, 
+ 0, 0, -128, 71, 3, 
+ 123, 3, 124, 5, 0, 
+ 1, 2, 3, 4, 1, 
+ 0, 1, 9, 0, 9, 
+ 2, 0, 1, 0, 1, 
  0, 1, 0, 1, 0, 
  0, 2, 1, 0, 0, 
  1, 0, 0, 1, 0, 
- 0, 1, 0, 0, 3, 
+ 0, 1, 0, 0, 1, 
+ 0, 0, 3, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 2, 0, 0, 0, 1, 
+ 0, 0, 0, 0, 0, 
+ 1, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 0, 2, 0, 0, 
- 0, 1, 0, 0, 0, 
- 0, 0, 1, 0, 0, 
  0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
+ 0, 0, 1, 0, 0, 
+ 0, 0, -3, 0, 6, 
+ 0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
  0, 0, 0, 0, 1, 
- 0, 0, 0, 0, -3, 
- 0, 6, 0, 0, 0, 
- 1, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 1, 0, 0, 0, 
- 0, 0, 2, 0, 0, 
+ 0, 0, 1, 0, 0, 
+ 0, 0, 0, 3, 0, 
  0, 0, 1, 0, 0, 
  0, 1, 0, 0, 0, 
- 0, 1, 0, 0, 0, 
- 0, 0, 0, 0, -1, 
- 0, 4, 0, 0, 0, 
- 1, 0, 0, 0, 3, 
  0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 2, 0, 
+ 0, 0, 0, 0, 3, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 1, 0, 
+ 0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, -1, 0, 4, 0, 
  0, 0, 1, 0, 0, 
- 0, 0, 2, 0, 0, 
+ 0, 3, 0, 0, 0, 
+ 0, 1, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
  0, 0, 1, 0, 0, 
+ 0, 2, 0, 0, 0, 
+ 0, 0, 3, 0, 0, 
+ 0, 1, 0, 0, 0, 
+ 0, 0, 0, 1, 0, 
+ 0, 1, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 2, 0, 
+ 0, 1, 0, 0, 0, 
+ 2, 0, 0, 0, 0, 
  0, 4, 0, 0, 0, 
- 0, 0, 16, 1, 0, 
- 0, 1, 0, 0, 1, 
+ 1, 0, 0, 0, 0, 
  0, 0, 1, 0, 0, 
- 1, 0, 0, 3, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 4, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 0, 
  1, 0, 0, 1, 0, 
- 0, 0, 3, 9, 0, 
- 0, 0, 14, 0, 0, 
+ 0, 0, 1, 0, 0, 
+ 0, 2, 0, 0, 0, 
  0, 0, 0, 2, 0, 
- 0, 25, 0, 0, 0, 
- 16, 0, 0, 0, 0, 
+ 0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 1, 0, 0, 0, 
+ 2, 0, 0, 0, 0, 
+ 0, 3, 0, 0, 0, 
+ 0, 1, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- 0, 0, 52, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 2, 0, 
+ 0, 0, 0, 0, 3, 
  0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 0, 
+ 1, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
  0, 1, 0, 0, 0, 
+ 0, 0, 2, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 5, 0, 1, 0, 1, 
+ 2, 0, 0, 0, 0, 
+ 0, 1, 0, 0, 1, 
+ 0, 0, 0, 0, 0, 
  0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 1, 0, 1, 0, 
+ -121, 0, 2, 0, 0, 
  0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 1, 0, 0, 
+ 1, 0, 0, 0, 0, 
+ 0, 0, -1, 3, 0, 
  0, 1, 0, 0, 0, 
- 0, 0, 1, 1, 0, 
+ 2, 1, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 1, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 1, 0, 0, 0, 1, 
+ 0, 0, 0, 1, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 1, 0, 0, 
+ 1, 0, 0, 1, 0, 
+ -5, -17, 27, 0, 1, 
+ 0, 0, 0, 0, 2, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 4, 0, 
+ 0, 0, 0, 0, 1, 
+ 0, 0, 0, 0, 16, 
+ 1, 0, 0, 1, 0, 
+ 0, 1, 0, 0, 1, 
+ 0, 0, 1, 0, 0, 
+ 3, 0, 1, 0, 0, 
+ 1, 0, 0, 0, 3, 
+ 9, 0, 0, 0, 14, 
+ 0, 0, 0, 0, 0, 
+ 2, 0, 0, 25, 0, 
+ 0, 0, 16, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 0, 0, 0, 0, 0, 
+ 57, 0, 0, 0, 0, 
+ 0, 1, 0, 0, 1, 
  0, 0, 0, 0, 0, 
+ 1, 1, 0, 0, 0, 
  0, 0, 0, 0, 0, 
- -5, 11, 0, 1, 0, 
+ 0, 0, 0, 2, 0, 
+ 1, 0, 0, 0, 0, 
+ -7, 13, 0, 1, 0, 
  0, 1, 0, 0, 3, 
  0, 0, 0, 0, 1, 
  0, 1, 0, 0, 0, 
  -2, 0, 6, 0, 0, 
  0, 0, 1, 0, 0, 
  0, 0, 2, 0, 0, 
- 1, 0, 0, 1, 1, 
+ 1, 0, 0, 1, 0, 
+ 0, 1, 1, 1, 1, 
  1, 1, 1, 1, 1, 
- 1, 1, 1, 0, 0, 
- 0, 1, 0, 0, 1, 
- 0, 0, 1, 0, 1, 
+ 1, 1, 1, 1, 0, 
+ 0, 0, 1, 0, 0, 
+ 1, 0, 0, 1, 0, 
+ 1, 0, 0, 0, 121, 
  0, 0, 0, 0, 5 
  };
 
-static const long int internal_size = 5340;
+static const long int internal_size = 8705;
 /* end of file!
  */
\ No newline at end of file
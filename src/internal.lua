@@ -12,13 +12,15 @@ local _REG = ...
 local PTR  = _REG.props
 local setvalue = _REG._setvalue
 local setport  = _REG._setport
+local setchannel = _REG._setchannel
 local major, minor = ladspa.getVersion()
 
 local defaults = {
 	name = 'unnamed',
 	maker = 'no author',
 	copyright = 'unlicensed',
-	realtime  = false
+	realtime  = false,
+	worker    = false
 }
 
 assert(info, "info table must be created!");
@@ -31,8 +33,18 @@ end
 
 v = info.label
 assert(type(v) == "string", "info.label must be a string")
+assert(not v:find("[\r\n\t]"), "info.label must be a single line without tabs")
 setvalue(PTR, "label", v)
 
+-- LADSPA UniqueID (hash of the label by default)
+v = info.id
+if v ~= nil then
+	if type(v) ~= "number" or v < 1 or v > 0xFFFFFF or math.floor(v) ~= v then
+		error("info.id must be integer in range 1..16777215!")
+	end
+	setvalue(PTR, "id", v)
+end
+
 v = info.luaLadspaVersionMajor - major
 if v ~= 0 then
 	error(string.format("Plugin is created for %s lualadspa version!", 
@@ -43,7 +55,98 @@ if info.luaLadspaVersionMinor > minor then
 	error("Plugin is created for newer minor lualadspa version!")
 end
 
+v = info.oversample or 1
+if v ~= 1 and v ~= 2 and v ~= 4 and v ~= 8 then
+	error("info.oversample must be 1, 2, 4 or 8!")
+end
+setvalue(PTR, "oversample", v)
+
+-- async block processing (block size), for non realtime plugins only
+v = info.async
+if v == true then v = 1024 end
+if v then
+	if type(v) ~= "number" or v < 32 or v > 65536 or math.floor(v) ~= v then
+		error("info.async must be true or block size in range 32..65536!")
+	end
+	if info.realtime then
+		error("realtime plugin can't be asynchronous!")
+	end
+	setvalue(PTR, "async", v)
+end
+
+-- flush denormals around run() (on by default)
+v = info.flushDenormals
+if v == nil then v = true end
+assert(type(v) == "boolean", "info.flushDenormals must be boolean")
+setvalue(PTR, "flushDenormals", v)
+
+-- strict mode : allocations in run() after warmup are counted,
+-- logged with traceback or denied
+local modes = {count = 1, log = 2, fail = 3}
+v = info.strict
+if v == true then v = "log" end
+if v then
+	if not modes[v] then
+		error("info.strict must be true, \"count\", \"log\" or \"fail\"!")
+	end
+	setvalue(PTR, "strict", modes[v])
+end
+v = info.warmup or 16
+if type(v) ~= "number" or v < 0 or math.floor(v) ~= v then
+	error("info.warmup must be number of blocks!")
+end
+setvalue(PTR, "warmup", v)
+
+-- instances kept after cleanup() for reuse (if plugin has reset())
+v = info.pool or 2
+if type(v) ~= "number" or v < 0 or v > 64 or math.floor(v) ~= v then
+	error("info.pool must be number of instances in range 0..64!")
+end
+setvalue(PTR, "poolSize", v)
+
+-- plugins without reset() are reused only with snapshot of their globals
+v = info.snapshot
+if v == nil then v = false end
+assert(type(v) == "boolean", "info.snapshot must be boolean")
+setvalue(PTR, "snapshot", v)
+
 assert(ports, "ports table must be created!");
+
+-- channel groups : port with channels = N is replicated N times
+-- ("name 1" .. "name N"), and runChannel() is called for each channel
+-- with its own ports.
+local expanded = {}
+local grouped = {} -- expanded port index -> channel
+local channels = nil
+
+for i = 1, #ports do
+	local p = ports[i]
+	assert(type(p) == "table", "ports must be proper lua array of tables!")
+	local n = p.channels
+	if n == nil then
+		expanded[#expanded + 1] = p
+	else
+		if type(n) ~= "number" or n < 1 or n > 64 or math.floor(n) ~= n then
+			error("channels must be an integer in range 1..64 (port index is "..
+				tostring(i).." )")
+		end
+		if channels and channels ~= n then
+			error("all channel groups must have same number of channels!")
+		end
+		channels = n
+		local name = p.name or "Port "..tostring(i)
+		assert(type(name) == "string", "Port name must be a string")
+		for ch = 1, n do
+			local c = table.clone(p)
+			c.name = name.." "..tostring(ch)
+			c.channels = nil
+			expanded[#expanded + 1] = c
+			grouped[#expanded] = ch
+		end
+	end
+end
+
+ports = expanded -- to keep new names anchored
 v = #ports
 
 if v <= 0 then
@@ -52,6 +155,7 @@ end
 
 -- set ports count
 setvalue(PTR, "portCount", v);
+setvalue(PTR, "channels", channels or 0);
 
 -- constants from ladspa.h
 local TYPE_INPUT   = 0x1
@@ -196,15 +300,22 @@ local function doPort(p, i)
 	)
 
 	setport(PTR, i, name, desc, hint, min, max)
+
+	-- host reads plugin latency from output control port with this name
+	if isOut and isControl and string.lower(name) == "latency" then
+		setvalue(PTR, "latencyPort", i)
+	end
 end
 
 for i = 1, #ports do
 	local v = ports[i]
-	assert(type(v) == "table", "ports must be proper lua array of tables!")
 	local ok, msg = pcall(doPort, v, i)
 	if not ok then
 		error(msg.." (port index is "..tostring(i).." )")
 	end
+	if grouped[i] then
+		setchannel(PTR, i, grouped[i])
+	end
 end
 
 -- do dirty stuff to optimize master state and init properties
@@ -225,10 +336,14 @@ table.freeze(ports)
 
 _REG._setvalue = nil
 _REG._setport = nil
+_REG._setchannel = nil
 master_need = nil
 PTR = nil
 setvalue = nil
 setport = nil
+setchannel = nil
+expanded = nil
+grouped = nil
 defaults = nil
 porttype = nil
 porthint = nil
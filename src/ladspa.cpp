@@ -18,6 +18,9 @@
  */
 
 #include "lualadspa.hpp"
+#include "lualadspa_c.h"
+#include <chrono>
+#include <cstring>
 
 const std::string vstrformat(const char * const fmt, va_list args) {
 	va_list args2;
@@ -143,36 +146,53 @@ bool loadFileContent(const char* finm, std::string& buff) {
 
 #include <vector>
 
-std::shared_ptr<PluginProperties> LoadPlugin(const char* name) {
-	std::string code;
-	if (!loadFileContent(name, code)) {
-		return nullptr; // error
+PlugPropShared LoadPlugin(const char* name,
+		std::shared_ptr<const std::string> bytecode) {
+	if (!bytecode) {
+		std::string code;
+		if (!loadFileContent(name, code)) {
+			TraceFile(name); // missing chain stage or graph node
+			TraceError("can't open file");
+			return nullptr; // error
+		}
+		TraceFile(name, &code);
+		std::string compiled;
+		LuaState::compileCode(code.c_str(), code.size(), compiled);
+		bytecode = std::make_shared<const std::string>(std::move(compiled));
 	}
-	std::string bytecode;
-	LuaState::compileCode(code.c_str(), code.size(), bytecode);
-	code.clear();
 
-	// we need state here
+	// we need state here, but only until plugin is validated
 	auto p = std::make_shared<PluginProperties>();
-	LuaState& L = p.get()->master;
+	LuaState L;
 	InitMasterState(L);
 
-	p.get()->bytecode = bytecode;
-	logInfo("length : %li", bytecode.size());
-	if (!L.loadBytecode(bytecode, name)) {
+	logInfo("length : %li", bytecode->size());
+	p->bytecode = bytecode;
+	if (!L.loadBytecode(*p->bytecode, name)) {
 		// can't continue
 		luaerror:
-		bytecode = lua_isstring(L, -1) ? lua_tostring(L, -1) : "?";
-		logError("Can't load plugin %s! Error : %s!", name, bytecode.c_str());
+		TraceError(lua_isstring(L, -1) ? lua_tostring(L, -1) : "?");
+		logError("Can't load plugin %s! Error : %s!", name,
+			lua_isstring(L, -1) ? lua_tostring(L, -1) : "?");
 		return nullptr;
 	}
 	logInfo("Compiles sucessfully");
+	SetProperties(L, p.get());
 	// attempt to set values
 	if (lua_pcall(L, 0, 1, 0) != LUA_OK) goto luaerror;
 	logInfo("Runs successfully");
 	lua_pop(L, 1);
+	// chain and graph manifests : ports are made from ports of the stages
+	if (lua_getfield(L, LUA_GLOBALSINDEX, "chain") != LUA_TNIL) {
+		lua_pop(L, 1);
+		if (!LoadChain(L, p.get(), name)) goto luaerror;
+	} else if (lua_getfield(L, LUA_GLOBALSINDEX, "graph") != LUA_TNIL) {
+		lua_pop(L, 2);
+		if (!LoadGraph(L, p.get(), name)) goto luaerror;
+	} else lua_pop(L, 2);
 	// and parse it + do some internal stuff to optimize master state
 	if (!InitMasterValues(L, p.get())) goto luaerror;
+	if (p->poolSize > 0) p->pool = NewInstancePool();
 	return p; // well done!
 }
 
@@ -180,17 +200,48 @@ std::shared_ptr<PluginProperties> LoadPlugin(const char* name) {
  * LADSPA_Descriptor here
  */
 
+/*
+ * Luau calls it with gc >= 0 before and after each GC step, and with -1
+ * on loop back edges and calls - keep this path short!
+ */
+static void interrupt(lua_State* L, int gc) {
+	PluginHandle* H = reinterpret_cast<PluginHandle*>(lua_callbacks(L)->userdata);
+	if (gc >= 0) TelemetryGC(H);
+	else if (UNLIKELY(H->L.allocdata.pending)) ReportAllocation(H, L);
+}
+
+static bool hasHook(PluginHandle* handle, const char* field);
+
 PluginHandle* makeHandle(PlugPropShared props, unsigned long rate) {
 	auto handle = std::make_unique<PluginHandle>();
 	PluginHandle* H = handle.get();
 	H->P = props;
 	H->samplerate = rate;
 	H->shutdown = false;
+	H->flushDenormals.store(props->flushDenormals, std::memory_order_relaxed);
+	H->messages = NewMessageQueue();
+	if (props->strict >= STRICT_LOG)
+		H->reports = std::make_unique<AllocationReport[]>(max_strict_reports);
 	LuaState& L = handle.get()->L;
 	InitInstanceState(L);
-	std::string str = props->bytecode;
+	SetProperties(L, props.get());
+	lua_pushlightuserdata(L, H);
+	lua_setfield(L, LUA_REGISTRYINDEX, "handle");
+	lua_callbacks(L)->userdata = H;
+	lua_callbacks(L)->interrupt = interrupt;
+	// samplerate is known before main chunk (native objects need it)
+	// oversampled plugin just sees higher samplerate
+	lua_pushnumber(L, (double)H->samplerate * props->oversample);
+	lua_setfield(L, LUA_REGISTRYINDEX, "samplerate");
+	if (props->oversample > 1) H->oversampler = std::make_unique<Oversampler>(
+		props->oversample, props->portCount, props->portDescriptors.get());
+	std::string str;
 
-	if (!L.loadBytecode(str, props->name)) {
+	if (props->graph) { // nodes are separate instances
+		if (!LoadGraphInstance(H)) goto luaerror;
+	} else if (!props->stages.empty()) { // chain runs it's stages instead
+		if (!LoadChainInstance(H)) goto luaerror; // buffers are made too
+	} else if (!L.loadBytecode(*props->bytecode, props->name)) {
 		// can't continue
 		luaerror:
 		str = lua_tostring(L, -1);
@@ -198,135 +249,389 @@ PluginHandle* makeHandle(PlugPropShared props, unsigned long rate) {
 		logError("Can't instanciate plugin %s! Error : %s!", props->name,
 			str.c_str());
 		return nullptr;
+	} else {
+		// attempt to call
+		if (lua_pcall(L, 0, 0, 0) != LUA_OK) goto luaerror;
+		// final step
+		InitInstanceBuffers(L, H);
 	}
-	// attempt to call
-	if (lua_pcall(L, 0, 0, 0) != LUA_OK) goto luaerror;
-	// final step
-	InitInstanceBuffers(L, H);
+	H->mainLatency = H->latency;
+	// without reset() instance can be reused only with snapshot (opt-in)
+	if (props->pool && props->snapshot && !props->worker && !props->graph &&
+			!hasHook(H, "reset"))
+		TakeSnapshot(H);
+	if (props->worker) H->worker = StartWorker(H);
+	if (props->async) H->async = NewAsyncRunner(H);
+	H->telemetry = NewTelemetry(H);
+	RegisterInstance(H);
 	return handle.release();
 }
 
-static void* newinstance(const LADSPA_Descriptor* D, unsigned long rate) {
-	auto P = *(reinterpret_cast<PlugPropShared*> (
-		D->ImplementationData));
-	return makeHandle(P, rate);
+/*
+ * ImplementationData of descriptors. Descriptor is made from the plugin
+ * database, and plugin is loaded by the first instantiate() (if it was
+ * not loaded by the scan already).
+ */
+struct PluginSlot {
+	std::mutex lock;
+	std::string file;
+	const PluginRecord* record; // strings of the descriptor are here
+	std::vector<const char*> portNames;
+	PlugPropShared props;
+	bool failed = false; // don't try again
+};
+
+static bool sameProperties(const PluginProperties* P, const PluginRecord& R) {
+	if (R.label != P->label || R.portDescriptors.size() != P->portCount)
+		return false;
+	for (size_t i = 0; i < P->portCount; i++)
+		if (R.portDescriptors[i] != P->portDescriptors[i] ||
+			R.portNames[i] != P->portNames[i]) return false;
+	return true;
 }
 
-static void cleaninstance(void* state) {
-	auto handle = reinterpret_cast<PluginHandle*>(state);
-	delete handle;
+static PlugPropShared slotProperties(PluginSlot* S) {
+	std::lock_guard<std::mutex> guard(S->lock);
+	if (S->props || S->failed) return S->props;
+	const char* file = S->file.c_str();
+	PlugPropShared P = LoadPlugin(file, S->record->bytecode);
+	if (!P) P = LoadPlugin(file); // cached bytecode is bad?
+	if (P && !sameProperties(P.get(), *S->record)) {
+		logError("Plugin %s was changed after host loaded it, restart the host!",
+			file);
+		P = nullptr;
+	}
+	S->failed = !P;
+	S->props = P;
+	return P;
 }
 
-#define BUFFNAME "_bufferMT"
+static void* newinstance(const LADSPA_Descriptor* D, unsigned long rate) {
+	auto P = slotProperties(reinterpret_cast<PluginSlot*>(D->ImplementationData));
+	if (!P) return nullptr;
+	if (PluginHandle* H = TakeInstance(P, rate)) return H; // warm one
+	return makeHandle(P, rate);
+}
 
 static void connectport(void* state, unsigned long idx, sample_type* data) {
 	auto handle = reinterpret_cast<PluginHandle*>(state);
 	if (handle->shutdown) return; // oh no
-	LuaState& L = handle->L;
-	if (lua_getfield(L, LUA_REGISTRYINDEX, "buffers") != LUA_TTABLE) {
-		logError("Connect : no buffers in the registry");
-		lua_pop(L, 1);
+	if (idx >= handle->P->portCount) {
+		logError("Connect : bad port index %i!", (int)idx);
 		return;
 	}
-	if (lua_rawgeti(L, -1, idx+1) != LUA_TUSERDATA) {
-		logError("no buffer in the registry at index %i!", idx);
-		lua_pop(L, 2);
-		return;
+	// buffers are updated in run(), host may reconnect ports at any time
+	handle->connected[idx] = data;
+}
+
+/*
+ * Pushes callback of the plugin (or of the chain stage),
+ * returns false if there is no such function
+ */
+static bool gethook(PluginHandle* handle, size_t stage, const char* field) {
+	LuaState& L = handle->L;
+	if (handle->chain) {
+		PushStage(handle, stage);
+		lua_getfield(L, -1, field);
+		lua_remove(L, -2);
+	} else lua_getfield(L, LUA_GLOBALSINDEX, field);
+	if (lua_isfunction(L, -1)) return true;
+	lua_pop(L, 1);
+	return false;
+}
+
+// number of stages to call hooks for (1 if plugin is not a chain)
+static size_t stagecount(PluginHandle* handle) {
+	return handle->chain ? handle->P->stages.size() : 1;
+}
+
+// is field function in each stage?
+static bool hasHook(PluginHandle* handle, const char* field) {
+	for (size_t s = 0; s < stagecount(handle); s++) {
+		if (!gethook(handle, s, field)) return false;
+		lua_pop(handle->L, 1);
 	}
-	LadspaBuffer* B = reinterpret_cast<LadspaBuffer*> (
-		luaL_checkudata(L, -1, BUFFNAME) // crashes
-	);
-	B->buffer = data;
-	lua_pop(L, 2);
+	return true;
 }
 
 static void docall(lua_State* L, const char* field, PluginHandle* handle) {
-	if (lua_getfield(L, LUA_GLOBALSINDEX, field) != LUA_TFUNCTION) {
-		lua_pop(L, 1);
-		return;
-	}
-	int err = lua_pcall(L, 0, 0, 0);
-	if (err != LUA_OK) {
-		logError("Error while calling %s() : %s", field, lua_tostring(L, -1));
-		if (err == LUA_ERRMEM || err == LUA_ERRERR) {
-			// difficult situation...
-			handle->shutdown = true; 
+	for (size_t s = 0; s < stagecount(handle) && !handle->shutdown; s++) {
+		if (!gethook(handle, s, field)) continue;
+		int err = lua_pcall(L, 0, 0, 0);
+		if (err != LUA_OK) {
+			logError("Error while calling %s() : %s", field, lua_tostring(L, -1));
+			handle->errors++;
+			if (err == LUA_ERRMEM || err == LUA_ERRERR) {
+				// difficult situation...
+				handle->shutdown = true; 
+			}
+			lua_pop(L, 1);
 		}
-		lua_pop(L, 1);
 	}
 }
 
+/*
+ * Calls reset() of the plugin (of each stage, or of each graph node)
+ * before instance goes to the pool : it must return plugin to the state
+ * right after main chunk. Plugins without it are restored from snapshot,
+ * if they have one (info.snapshot).
+ * Returns false if instance can't be reused.
+ */
+static bool resetInstance(PluginHandle* handle) {
+	if (handle->shutdown || handle->activated || handle->worker) return false;
+	for (size_t i = 0; i < GraphNodeCount(handle); i++)
+		if (!resetInstance(GetGraphNode(handle, i))) return false;
+	LuaState& L = handle->L;
+	// reset() may set it again
+	if (handle->chain) RestoreChainLatency(handle);
+	else handle->latency = handle->mainLatency;
+	if (!handle->graph && hasHook(handle, "reset")) {
+		const size_t errors = handle->errors;
+		docall(L, "reset", handle);
+		if (handle->shutdown || handle->errors != errors) return false;
+	} else if (!handle->graph && !RestoreSnapshot(handle)) return false;
+	handle->errors = 0;
+	handle->flushDenormals.store(handle->P->flushDenormals,
+		std::memory_order_relaxed);
+	for (size_t i = 0; handle->connected && i < handle->P->portCount; i++)
+		handle->connected[i] = nullptr;
+	lua_gc(L, LUA_GCCOLLECT, 0);
+	auto& A = L.allocdata;
+	A.runAllocations = A.runBytes = A.strictViolations = 0;
+	A.peak = A.allocated;
+	return true;
+}
+
+static void cleaninstance(void* state) {
+	auto handle = reinterpret_cast<PluginHandle*>(state);
+	UnregisterInstance(handle);
+	LogAllocations(handle); // if host didn't deactivate it
+	if (resetInstance(handle) && PoolInstance(handle)) return;
+	delete handle;
+}
+
 static void activate(void* state) {
 	auto handle = reinterpret_cast<PluginHandle*>(state);
 	if (handle->shutdown) return; // oh no
+	for (size_t i = 0; i < GraphNodeCount(handle); i++)
+		activate(GetGraphNode(handle, i));
 	LuaState& L = handle->L;
 	auto top = lua_gettop(L);
+	if (handle->oversampler) handle->oversampler->reset();
+	handle->blocks = 0; // warmup again
+	handle->strictReports = 0;
+	handle->reported = 0;
 	docall(L, "activate", handle);
 	handle->activated = true;
 	if (top != lua_gettop(L))logError("bad top! (was %i, now %i)", top, lua_gettop(L));
+	PublishTelemetry(handle, 0, 0.0);
+	// lua state belongs to async thread until deactivate()
+	if (handle->async) StartAsync(handle);
+	if (handle->graph) StartGraph(handle);
 }
 
 static void deactivate(void* state) {
 	auto handle = reinterpret_cast<PluginHandle*>(state);
+	if (handle->async) StopAsync(handle);
+	if (handle->graph) StopGraph(handle);
+	for (size_t i = 0; i < GraphNodeCount(handle); i++)
+		deactivate(GetGraphNode(handle, i));
+	LogAllocations(handle); // run() is not called anymore
 	if (handle->shutdown) return; // oh no
 	LuaState& L = handle->L;
 	auto top = lua_gettop(L);
 	docall(L, "deactivate", handle);
 	handle->activated = false;
 	if (top != lua_gettop(L))logError("bad top! (was %i, now %i)", top, lua_gettop(L));
+	PublishTelemetry(handle, 0, 0.0);
 }
 
-static void run(void* state, unsigned long samplecount) {
-	auto handle = reinterpret_cast<PluginHandle*>(state);
-	LuaState& L = handle->L;
-	if (!handle->activated) logError("Plugin was not activated!");
-	if (handle->shutdown) return; // oh no
-
-	auto top = lua_gettop(L);
-	// for each external buffer
-	if (lua_getfield(L, LUA_REGISTRYINDEX, "buffers") != LUA_TTABLE) {
-		logError("Run : no buffers in the registry"); lua_pop(L, 1); return;
-	}
-
-	// TODO : this whole loop is not free... hmmm...
-	int cnt = lua_objlen(L, -1);
-	for (int i = 1; i <= cnt; i++) {
-		lua_rawgeti(L, -1, i);
-		LadspaBuffer* B = reinterpret_cast<LadspaBuffer*> (
-			luaL_checkudata(L, -1, BUFFNAME) // crashes, assumes it readonly
-		);
-		// control port will still have size 1
-		B->size = handle->P->portDescriptors[i-1] & LADSPA_PORT_CONTROL ? 1 : samplecount;
-		lua_pop(L, 1);
+/*
+ * Points port buffers to the host data (or to internal oversampled buffers)
+ * Returns block size for the plugin
+ */
+static unsigned long preparePorts(PluginHandle* handle,
+		sample_type* const* connected, unsigned long samplecount) {
+	const PluginProperties* P = handle->P.get();
+	Oversampler* O = handle->oversampler.get();
+	unsigned long n = O ? O->prepare(samplecount) : samplecount;
+	for (size_t i = 0; i < P->portCount; i++) {
+		LadspaBuffer* B = handle->ports[i];
+		const auto desc = P->portDescriptors[i];
+		if (IS_CONTROL(desc)) { // control port will still have size 1
+			B->buffer = connected[i];
+			B->size = 1;
+		} else if (O) {
+			B->buffer = IS_INPUT(desc) ?
+				O->upsample(i, connected[i], samplecount) : O->buffer(i);
+			B->size = n;
+		} else {
+			B->buffer = connected[i];
+			B->size = samplecount;
+		}
 	}
-	lua_pop(L, 1);
+	return n;
+}
 
-	if (lua_getfield(L, LUA_GLOBALSINDEX, "run") != LUA_TFUNCTION) {
-		lua_pop(L, 1);
-		if (top != lua_gettop(L)) logError("bad top! (was %i, now %i)", top, lua_gettop(L));
-		return;
+size_t PluginLatency(const PluginHandle* handle) {
+	size_t latency = handle->latency;
+	if (handle->oversampler) latency = latency / handle->oversampler->factor()
+		+ handle->oversampler->latency();
+	if (handle->async) latency += AsyncLatency(handle);
+	return latency;
+}
+
+static void finishPorts(PluginHandle* handle,
+		sample_type* const* connected, unsigned long samplecount) {
+	const PluginProperties* P = handle->P.get();
+	Oversampler* O = handle->oversampler.get();
+	if (O) {
+		for (size_t i = 0; i < P->portCount; i++) {
+			const auto desc = P->portDescriptors[i];
+			if (IS_AUDIO(desc) && IS_OUTPUT(desc))
+				O->downsample(i, connected[i], samplecount);
+		}
 	}
-	lua_pushnumber(L, samplecount);
+	if (P->latencyPort >= 0 && connected[P->latencyPort])
+		*connected[P->latencyPort] = (sample_type)PluginLatency(handle);
+}
 
-	int err = lua_pcall(L, 1, 0, 0);
+static bool callRun(PluginHandle* handle, const char* field, int nargs) {
+	LuaState& L = handle->L;
+	int err = lua_pcall(L, nargs, 0, 0);
 	if (err != LUA_OK) {
-		logError("Error while calling run() : %s", lua_tostring(L, -1));
-		if (err == LUA_ERRMEM || err == LUA_ERRERR) {
+		logError("Error while calling %s() : %s", field, lua_tostring(L, -1));
+		handle->errors++;
+		// allocation denied by strict mode is not a real out of memory
+		if ((err == LUA_ERRMEM && !L.allocdata.denied) || err == LUA_ERRERR) {
 			// difficult situation...
 			handle->shutdown = true; 
 		}
 		lua_pop(L, 1);
+		return false;
+	}
+	return true;
+}
+
+/*
+ * runChannel(size, channel, buffers of the channel...) is called
+ * for each channel group, one after another, after run()
+ */
+static void runChannels(PluginHandle* handle, unsigned long n) {
+	LuaState& L = handle->L;
+	const PluginProperties* P = handle->P.get();
+	if (lua_getfield(L, LUA_GLOBALSINDEX, "runChannel") != LUA_TFUNCTION) {
+		lua_pop(L, 1);
+		return;
+	}
+	lua_getfield(L, LUA_REGISTRYINDEX, "buffers");
+	const int func = lua_gettop(L) - 1, bufs = lua_gettop(L);
+	for (int ch = 0; ch < P->channels; ch++) {
+		const auto& list = P->channelPorts[ch];
+		if (!lua_checkstack(L, 3 + list.size())) break; // not in pcall!
+		lua_pushvalue(L, func);
+		lua_pushnumber(L, n);
+		lua_pushinteger(L, ch + 1);
+		for (int idx : list) lua_rawgeti(L, bufs, idx + 1);
+		if (!callRun(handle, "runChannel", 2 + list.size())) break;
+	}
+	lua_pop(L, 2);
+}
+
+// outputs of skipped block
+static void silenceOutputs(PluginHandle* handle, sample_type* const* connected,
+		unsigned long samplecount) {
+	const PluginProperties* P = handle->P.get();
+	for (size_t i = 0; i < P->portCount; i++) {
+		const auto desc = P->portDescriptors[i];
+		if (IS_AUDIO(desc) && IS_OUTPUT(desc) && connected[i])
+			std::memset(connected[i], 0, samplecount * sizeof(sample_type));
+	}
+}
+
+void ProcessBlock(PluginHandle* handle, sample_type* const* connected,
+		unsigned long samplecount) {
+	// host is saving or loading state right now, don't wait for it
+	std::unique_lock<std::mutex> guard(handle->stateLock, std::try_to_lock);
+	if (!guard.owns_lock()) {
+		silenceOutputs(handle, connected, samplecount);
+		return;
 	}
+	LuaState& L = handle->L;
+	DenormalGuard fpguard(handle->flushDenormals.load(std::memory_order_relaxed));
+	auto top = lua_gettop(L);
+	const auto start = std::chrono::steady_clock::now();
+	L.allocdata.inRun = true;
+	BeginStrictBlock(handle);
+	if (handle->worker) PollWorker(handle);
+	unsigned long n = preparePorts(handle, connected, samplecount);
+
+	// chain buffers are allocated for chain_block, bigger blocks go in parts
+	const unsigned long part = handle->chain ? chain_block : n;
+	for (unsigned long done = 0; done < n && !handle->shutdown; done += part) {
+		const unsigned long len = std::min(part, n - done);
+		if (handle->chain) PrepareChain(handle, done, len);
+		for (size_t s = 0; s < stagecount(handle) && !handle->shutdown; s++) {
+			if (!gethook(handle, s, "run")) continue;
+			lua_pushnumber(L, len);
+			callRun(handle, "run", 1);
+		}
+	}
+	if (handle->P->channels && !handle->shutdown) runChannels(handle, n);
+
+	finishPorts(handle, connected, samplecount);
 	if (top != lua_gettop(L)) logError("bad top! (was %i, now %i)", top, lua_gettop(L));
+	EndStrictBlock(handle);
+	L.allocdata.inRun = false;
+	PublishTelemetry(handle, samplecount, std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count());
+}
+
+static void run(void* state, unsigned long samplecount) {
+	auto handle = reinterpret_cast<PluginHandle*>(state);
+	if (!handle->activated) logError("Plugin was not activated!");
+	if (handle->shutdown) return; // oh no
+	if (handle->graph) RunGraph(handle, samplecount);
+	else if (handle->async) RunAsync(handle, samplecount);
+	else ProcessBlock(handle, handle->connected.get(), samplecount);
+}
+
+extern "C" void lualadspa_set_flush_denormals(LADSPA_Handle instance,
+		int enable) {
+	auto handle = reinterpret_cast<PluginHandle*>(instance);
+	if (handle) handle->flushDenormals.store(enable, std::memory_order_relaxed);
 }
 
-// holy right :D (you must release std::shared_ptr here!)
-LADSPA_Descriptor makeDescriptor(PlugPropShared prop) {
+// errors of the instance and of all graph nodes
+static void countErrors(PluginHandle* H, uint64_t& errors, bool& terminated) {
+	errors += H->errors;
+	terminated = terminated || H->shutdown;
+	for (size_t i = 0; i < GraphNodeCount(H); i++)
+		countErrors(GetGraphNode(H, i), errors, terminated);
+}
+
+extern "C" int lualadspa_errors(LADSPA_Handle instance, uint64_t* errors,
+		int* terminated) {
+	auto handle = reinterpret_cast<PluginHandle*>(instance);
+	if (!handle) return 0;
+	uint64_t n = 0;
+	bool dead = false;
+	countErrors(handle, n, dead);
+	if (errors) *errors = n;
+	if (terminated) *terminated = dead;
+	return 1;
+}
+
+// holy right :D (you must delete the slot here!)
+static LADSPA_Descriptor makeDescriptor(PluginSlot* S, unsigned long id) {
+	const PluginRecord& R = *S->record;
+	for (auto& name : R.portNames) S->portNames.push_back(name.c_str());
 	return (LADSPA_Descriptor) {
-		123, prop->label, default_properties, prop->name, prop->maker,
-		prop->copyright, prop->portCount, prop->portDescriptors.get(),
-		prop->portNames.get(), prop->portRangeHints.get(),
-		(void*)new PlugPropShared(prop), newinstance, connectport, activate, run, 
+		id, R.label.c_str(), R.realtime ? default_properties : 0,
+		R.name.c_str(), R.maker.c_str(), R.copyright.c_str(),
+		R.portDescriptors.size(), R.portDescriptors.data(),
+		S->portNames.data(), R.portRangeHints.data(),
+		(void*)S, newinstance, connectport, activate, run,
 		nullptr, nullptr, deactivate, cleaninstance
 	};
 }
@@ -334,6 +639,7 @@ LADSPA_Descriptor makeDescriptor(PlugPropShared prop) {
 // OS specific stuff is hidden behind the scenes
 
 #include <exception>
+#include <algorithm>
 
 static fsys::path empty_path;
 static fsys::path search_pathes[2] = {};
@@ -363,35 +669,313 @@ static const char* getHome() {
 }
 
 #include <stdlib.h>
+static fsys::path cache_path;
+static std::string module_pathes[2], cache_string; // for modules.cpp
+
 static void initPathes() {
+	const fsys::path home = getHome();
 	#ifdef _WIN32
 	search_pathes[0] = "C:/lualadspa/";
-	search_pathes[1] = (fsys::path(getHome()) / "AppData/Local/lualadspa/");
+	search_pathes[1] = (home / "AppData/Local/lualadspa/");
+	const char* local = getenv("LOCALAPPDATA");
+	cache_path = (local ? fsys::path(local) : home / "AppData/Local") /
+		"lualadspa/cache";
 	#else
 	search_pathes[0] = "/usr/share/lualadspa";
-	search_pathes[1] = (fsys::path(getHome()) / ".lualadspa");
+	search_pathes[1] = (home / ".lualadspa");
+	const char* xdg = getenv("XDG_CACHE_HOME");
+	cache_path = (xdg && *xdg ? fsys::path(xdg) : home / ".cache") / "lualadspa";
 	#endif
+	module_pathes[0] = search_pathes[1].string();
+	module_pathes[1] = search_pathes[0].string();
+	cache_string = cache_path.string();
+}
+
+const char* searchPathesIterator(long int idx) {
+	if (idx < 0 || idx >= 2 || module_pathes[idx].empty()) return nullptr;
+	return module_pathes[idx].c_str();
+}
+
+const char* cacheDirectory() {
+	return cache_string.empty() ? nullptr : cache_string.c_str();
+}
+
+/*
+ * Plugin index : hosts remember plugins by index of ladspa_descriptor()
+ * and by UniqueID, so both must never change, even if some files are
+ * removed, broken or added. Index file keeps label, id and file of each
+ * slot (one per line, tab separated), new plugins are appended to the
+ * end, and slots of missing ones stay with placeholder descriptor, that
+ * can't be instantiated. Delete the file to renumber plugins.
+ */
+static const char index_header[] = "lualadspa index 2";
+
+struct IndexEntry {
+	std::string label;
+	unsigned long id = 0; // 0 if not assigned yet
+	std::string file;
+};
+
+/*
+ * LADSPA ids are below 0x1000000 : 32 bit FNV-1a of the label, folded
+ * to 24 bits. Collisions are resolved by the index (next free id).
+ */
+static unsigned long labelID(const std::string& label) {
+	uint32_t h = 2166136261u;
+	for (unsigned char c : label) {
+		h ^= c;
+		h *= 16777619u;
+	}
+	h = (h >> 24) ^ (h & 0xFFFFFF);
+	return h ? h : 1;
+}
+
+static std::vector<IndexEntry> readIndex(const fsys::path& file) {
+	std::vector<IndexEntry> list;
+	std::error_code ec;
+	if (!fsys::exists(file, ec)) return list;
+	std::string data;
+	if (!loadFileContent(file.string().c_str(), data)) return list;
+	size_t pos = 0;
+	bool header = true;
+	while (pos < data.size()) {
+		size_t end = data.find('\n', pos);
+		if (end == std::string::npos) end = data.size();
+		std::string line = data.substr(pos, end - pos);
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		pos = end + 1;
+		if (header) {
+			if (line != index_header) {
+				logError("Bad plugin index %s, ignored!", file.string().c_str());
+				return list;
+			}
+			header = false;
+			continue;
+		}
+		IndexEntry e;
+		size_t a = line.find('\t'), b = line.find('\t', a + 1);
+		if (a == std::string::npos || b == std::string::npos) {
+			logError("Bad plugin index %s, ignored!", file.string().c_str());
+			return {};
+		}
+		e.label = line.substr(0, a);
+		e.id = std::strtoul(line.c_str() + a + 1, nullptr, 10);
+		e.file = line.substr(b + 1);
+		if (e.id > 0xFFFFFF) e.id = 0; // assigned again
+		list.push_back(e);
+	}
+	return list;
+}
+
+static void writeIndex(const fsys::path& file,
+		const std::vector<IndexEntry>& list) {
+	std::string data = std::string(index_header) + "\n";
+	for (auto& e : list)
+		data += strformat("%s\t%lu\t%s\n", e.label.c_str(), e.id, e.file.c_str());
+	// other hosts may read it right now
+	if (!ReplaceFile(file.string(), data))
+		logError("Can't write plugin index %s!", file.string().c_str());
+}
+
+static void* noinstance(const LADSPA_Descriptor* D, unsigned long) {
+	logError("Plugin %s is not available (removed or broken)!", D->Label);
+	return nullptr;
 }
 
 static volatile bool init_done = false;
 
 class LUALADSPA {
 	/*
-	 * Array of loaded plugins.
-	 * (Plugin properties are stored in ImplementationData!)
-	 * In's important to keep them in Shared pointer, so ImplementationData is actually a Shared Pointer on PluginProperties :)
+	 * Array of plugins.
+	 * (Plugin slot is stored in ImplementationData!)
+	 * Slot keeps plugin properties in Shared pointer, they are loaded by
+	 * the first instantiate(), descriptor is made from the database.
 	 * std::shared_ptr is thread safe, so there should be npo any problems, hopefully.
+	 * Placeholders have no ImplementationData.
+	 *
+	 * Only new and changed plugin files are loaded on library load, so
+	 * it takes the same time with any number of unchanged plugins.
 	 */
-	public:
 	std::vector<LADSPA_Descriptor> plugins;
-	private:
-	void tryLoadPlugins(const fsys::path& path) {
+	std::vector<IndexEntry> index; // of each slot
+	std::vector<PlugPropShared> loaded; // by the scan, for descriptors
+	std::vector<bool> ready, available;
+	std::map<unsigned long, size_t> ids; // used ids -> slot
+	std::vector<std::unique_ptr<std::string>> strings; // of placeholders
+	PluginDatabase db; // never changed after the scan (descriptors use it)
+	std::mutex lock;
+	fsys::path indexFile, dbFile;
+	bool changed = false;
+
+	const char* keep(const std::string& s) {
+		strings.push_back(std::make_unique<std::string>(s));
+		return strings.back()->c_str();
+	}
+	LADSPA_Descriptor makePlaceholder(size_t i) {
+		LADSPA_Descriptor D = {};
+		D.UniqueID = index[i].id;
+		D.Label = keep(index[i].label);
+		D.Name = keep(index[i].label + " (not available)");
+		D.Maker = D.Copyright = "None";
+		D.instantiate = noinstance;
+		return D;
+	}
+	// takes id of info.id (or of the label hash) for the slot, if it's free
+	void assignID(size_t i, unsigned long wanted) {
+		auto& e = index[i];
+		if (wanted && wanted != e.id) {
+			auto it = ids.find(wanted);
+			if (it == ids.end() || it->second == i) {
+				if (e.id) ids.erase(e.id);
+				e.id = wanted;
+				ids[wanted] = i;
+				changed = true;
+				return;
+			}
+			logError("Plugin %s : id %lu is already used by %s!", e.label.c_str(),
+				wanted, index[it->second].label.c_str());
+		}
+		if (e.id) return;
+		unsigned long id = labelID(e.label);
+		while (ids.count(id)) id = id % 0xFFFFFF + 1; // next free one
+		e.id = id;
+		ids[id] = i;
+		changed = true;
+	}
+
+	void scan(std::vector<fsys::path>& files, const fsys::path& path) {
 		for (auto const& entry : fsys::directory_iterator(path)) {
-			auto prop = LoadPlugin(entry.path().string().c_str());
-			if (prop) {
-				plugins.push_back(makeDescriptor(prop));
+			std::error_code ec;
+			if (!entry.is_regular_file(ec)) continue;
+			if (entry.path().extension() != ".lua") continue;
+			files.push_back(entry.path());
+		}
+	}
+
+	// loads new and changed plugin files, returns plugins loaded now
+	std::map<std::string, PlugPropShared> refresh(
+			const std::vector<fsys::path>& files) {
+		std::map<std::string, PlugPropShared> fresh;
+		PluginDatabase old = ReadDatabase(dbFile.string());
+		bool dirty = false;
+		for (auto& path : files) {
+			const std::string file = path.string();
+			auto it = old.find(file);
+			if (it != old.end() && IsRecordFresh(it->second, dirty)) {
+				if (!it->second.error.empty())
+					logError("Plugin %s is not changed since error : %s", file.c_str(),
+						it->second.error.c_str());
+				db[file] = std::move(it->second);
+				continue;
+			}
+			PlugPropShared props;
+			db[file] = ScanPlugin(file, props);
+			if (props) fresh[file] = props;
+			dirty = true;
+		}
+		if (dirty || db.size() != old.size()) WriteDatabase(dbFile.string(), db);
+		return fresh;
+	}
+
+	void makeIndex(const std::vector<fsys::path>& files) {
+		auto fresh = refresh(files);
+		index = readIndex(indexFile);
+		std::map<std::string, size_t> slots; // by label
+		std::map<std::string, size_t> known; // by file
+		for (size_t i = 0; i < index.size(); i++) {
+			auto& e = index[i];
+			if (e.id && !ids.count(e.id)) ids[e.id] = i;
+			else e.id = 0; // broken index?
+			slots.emplace(e.label, i);
+			if (!e.file.empty()) known.emplace(e.file, i);
+		}
+		available.assign(index.size(), false);
+		loaded.resize(index.size());
+		std::vector<std::string> moved; // new files, or with new label
+		for (auto& path : files) {
+			const std::string file = path.string();
+			const PluginRecord& R = db[file];
+			if (!R.error.empty()) continue;
+			if (file.find_first_of("\t\r\n") != std::string::npos) {
+				logError("Plugin file name %s has tabs or newlines, ignored!",
+					file.c_str());
+				continue;
+			}
+			auto k = known.find(file);
+			if (k == known.end() || index[k->second].label != R.label) {
+				if (k != known.end()) { // other plugin now, slot is kept
+					logError("Label of plugin %s was changed to %s!", file.c_str(),
+						R.label.c_str());
+					index[k->second].file.clear();
+					changed = true;
+				}
+				moved.push_back(file);
+				continue;
 			}
+			available[k->second] = true;
+		}
+		for (auto& file : moved) {
+			const PluginRecord& R = db[file];
+			auto s = slots.find(R.label);
+			size_t i;
+			if (s != slots.end()) { // moved file
+				i = s->second;
+				if (available[i]) {
+					logError("Plugin %s has the same label %s as other one, ignored!",
+						file.c_str(), R.label.c_str());
+					continue;
+				}
+			} else {
+				i = index.size();
+				index.push_back({R.label, 0, ""});
+				slots.emplace(R.label, i);
+				available.push_back(false);
+				loaded.push_back(nullptr);
+			}
+			index[i].file = file;
+			available[i] = true;
+			changed = true;
+		}
+		// info.id first : free wanted ids are taken until nothing changes,
+		// as plugin may want id, that other one gives up later in slot order
+		for (bool again = true; again; ) {
+			again = false;
+			for (size_t i = 0; i < index.size(); i++) {
+				if (!available[i]) continue;
+				const unsigned long wanted = db[index[i].file].id;
+				if (!wanted || wanted == index[i].id || ids.count(wanted)) continue;
+				assignID(i, wanted);
+				again = true;
+			}
+		}
+		// left ones are collisions (logged), or take hash of the label
+		for (size_t i = 0; i < index.size(); i++) {
+			if (!available[i]) continue;
+			assignID(i, db[index[i].file].id);
+			auto f = fresh.find(index[i].file);
+			if (f != fresh.end()) loaded[i] = f->second;
+		}
+		for (size_t i = 0; i < index.size(); i++) {
+			if (available[i]) continue;
+			logInfo("Plugin %s is not available, slot is kept", index[i].label.c_str());
+			assignID(i, 0);
 		}
+		plugins.resize(index.size());
+		ready.assign(index.size(), false);
+		if (changed) writeIndex(indexFile, index);
+		changed = false;
+	}
+
+	// makes descriptor of the slot
+	void prepare(size_t i) {
+		if (available[i]) {
+			auto S = new PluginSlot;
+			S->file = index[i].file;
+			S->record = &db.at(S->file);
+			S->props = std::move(loaded[i]);
+			plugins[i] = makeDescriptor(S, index[i].id);
+		} else plugins[i] = makePlaceholder(i);
+		ready[i] = true;
 	}
 	public:
 	LUALADSPA() {
@@ -404,22 +988,28 @@ class LUALADSPA {
 		}
 
 		// enum pathes
+		std::vector<fsys::path> files;
 		for (int i = 0; i < 2; i++) {
 			auto& p = search_pathes[i];
 			try {
 				logInfo("Process %s...", p.c_str());
-				tryLoadPlugins(p);
+				scan(files, p);
 			} catch (std::exception& e) {
 				logError("Can't process directory %s : %s", p.c_str(), e.what());
 			};
 		}
+		// sorted, so new plugins get same indices everywhere
+		std::sort(files.begin(), files.end());
+		indexFile = cache_path / "plugins.index";
+		dbFile = cache_path / "plugins.db";
+		makeIndex(files);
 		logInfo("All directories was passed successfully!");
 		init_done = true;
 	}
 	~LUALADSPA() {
 		for (auto &i : plugins) {
-			auto prop = reinterpret_cast<PlugPropShared*>(i.ImplementationData);
-			delete prop; // yeah...
+			auto slot = reinterpret_cast<PluginSlot*>(i.ImplementationData);
+			delete slot; // yeah...
 		}
 		// no plugins available
 		plugins.clear();
@@ -427,15 +1017,62 @@ class LUALADSPA {
 		if (outlog != stderr) fclose(outlog);
 		init_done = false;
 	}
+	// what is known about plugin files (see lualadspa_c.h)
+	size_t catalog(lualadspa_plugin_cb cb, void* userdata) {
+		std::lock_guard<std::mutex> guard(lock);
+		std::map<std::string, size_t> slot; // by file
+		for (size_t i = 0; i < index.size(); i++)
+			if (available[i]) slot[index[i].file] = i;
+		size_t n = 0;
+		for (auto& [file, R] : db) {
+			struct lualadspa_plugin_info info = {};
+			info.file = file.c_str();
+			info.index = -1;
+			auto s = slot.find(file);
+			if (s != slot.end()) {
+				info.index = s->second;
+				info.id = index[s->second].id;
+			}
+			if (R.error.empty()) {
+				info.label = R.label.c_str();
+				info.name = R.name.c_str();
+				info.ports = R.portDescriptors.size();
+				if (s == slot.end()) info.error = "label is used by other plugin";
+			} else info.error = R.error.c_str();
+			if (cb) cb(&info, userdata);
+			n++;
+		}
+		for (size_t i = 0; i < index.size(); i++) {
+			if (available[i]) continue;
+			struct lualadspa_plugin_info info = {};
+			info.label = index[i].label.c_str();
+			info.index = i;
+			info.id = index[i].id;
+			info.error = "not available (removed or broken)";
+			if (cb) cb(&info, userdata);
+			n++;
+		}
+		return n;
+	}
+
+	const LADSPA_Descriptor* get(size_t i) {
+		if (i >= plugins.size()) return nullptr;
+		std::lock_guard<std::mutex> guard(lock);
+		if (!ready[i]) prepare(i);
+		return plugins.data() + i;
+	}
 };
 
 class LUALADSPA* _G = nullptr;
 
 extern "C" const LADSPA_Descriptor* ladspa_descriptor(unsigned long Index) {
 	if (!_G) _G = new LUALADSPA;
-	if (Index >= _G->plugins.size())
-		return NULL;
-	return _G->plugins.data() + Index;
+	return _G->get(Index);
+}
+
+extern "C" size_t lualadspa_plugins(lualadspa_plugin_cb cb, void* userdata) {
+	if (!_G) _G = new LUALADSPA;
+	return _G->catalog(cb, userdata);
 }
 
 static class DEST {
@@ -61,6 +61,10 @@ constexpr int version_minor = 3;
 #include <cstdarg>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <atomic>
+#include <map>
+#include <vector>
 
 const std::string strformat(const char * const fmt, ...);
 const std::string vstrformat(const char * const fmt, va_list args);	
@@ -68,12 +72,35 @@ void  logError(const char* message, ...);
 void logInfo(const char* message, ...);
 bool loadFileContent(const char* finm, std::string& buff);
 
+// what happens on allocation in run() after warmup (info.strict)
+enum StrictMode {
+	STRICT_OFF = 0,
+	STRICT_COUNT,
+	STRICT_LOG, // + log with traceback
+	STRICT_FAIL // + allocation fails (lua error in run())
+};
+
 // RAII Lua State
 class LuaState {
 	private :
 	struct LimitedAllocData {
 		size_t allocated = 0; // how many bytes was allocated
 		size_t maxlimit = 32 << 20; // 32 Mb
+		size_t peak = 0; // high-water mark of allocated
+		size_t buffers = 0; // storage of ladspa buffers (part of allocated)
+		size_t allocations = 0; // new blocks and growing reallocations
+		size_t frees = 0;
+		size_t bytes = 0; // total allocated bytes (never decreases)
+		size_t largest = 0; // largest single block
+		size_t failed = 0; // allocations over the limit (or malloc failures)
+		size_t runAllocations = 0; // the same, but inside run() only
+		size_t runBytes = 0;
+		bool inRun = false; // set by ProcessBlock()
+		int strict = STRICT_OFF; // for current block (after warmup only)
+		size_t strictViolations = 0; // allocations in strict mode
+		size_t lastViolation = 0; // bytes
+		bool pending = false; // violation is not reported yet
+		bool denied = false; // allocation was failed by strict mode
 	};
 	// limited allocator function
 	static void* limitedAlloc(void* ud, void* p, size_t oldsz, size_t nsz) {
@@ -98,20 +125,83 @@ class LuaState {
 	double memoryUsageFactor();
 
 	void limitMemoryKB(size_t KBytes);
-	bool loadBytecode(const char* buff, size_t size, const char* name);	
-	bool loadBytecode(const std::string &bc, const char* name);
+	// env is stack index of environment table (0 is globals)
+	bool loadBytecode(const char* buff, size_t size, const char* name,
+		int env = 0);
+	bool loadBytecode(const std::string &bc, const char* name, int env = 0);
 	static void compileCode(const char* src, size_t len, std::string& out);
 };
 
+struct PluginProperties;
+using PlugPropShared = std::shared_ptr<PluginProperties>;
+
+/*
+ * Warm instances of the plugin type, kept after cleanup() to be reused
+ * by instantiate() with the same samplerate (see pool.cpp)
+ */
+class InstancePool;
+struct InstancePoolDeleter {
+	void operator()(InstancePool* P) const; // destroys pooled instances
+};
+using InstancePoolPtr = std::unique_ptr<InstancePool, InstancePoolDeleter>;
+// memory of all pooled instances of all plugins
+constexpr size_t pool_memory_limit = 64 << 20;
+
+/*
+ * Stage of the chain plugin (see chain.cpp) : another plugin, running in
+ * the lua state of the chain, in it's own environment.
+ */
+struct ChainStage {
+	PlugPropShared props; // loaded as usual plugin (readonly)
+	std::vector<int> ports; // chain port index of each stage port, or below
+};
+constexpr int chain_hidden = -1; // latency port of the stage (not exposed)
+// audio port k connected to previous or next stage is -(k + 2)
+// stages run() at most this number of samples at once (see chain.cpp)
+constexpr size_t chain_block = 1024;
+
+/*
+ * Node of the graph plugin (see graph.cpp) : another plugin with it's own
+ * instance and lua state, so independent nodes may run in parallel.
+ */
+struct GraphNode {
+	PlugPropShared props; // loaded as usual plugin (readonly)
+	// graph port index of each node port (>= 0), internal buffer (see
+	// below) or graph_internal : zeros for audio input, dummy otherwise
+	std::vector<int> ports;
+	std::vector<int> next; // nodes using outputs of this one
+	int inputs = 0; // number of nodes this one waits for
+};
+constexpr int graph_internal = -1;
+// internal buffer (audio output of some node) e is -(e + 2)
+
+struct GraphLayout {
+	std::vector<GraphNode> nodes; // in topological order
+	size_t inputs = 0; // audio ports of the graph, inputs are first ports
+	std::vector<int> outputs; // buffer of each graph audio output (or -1)
+	std::vector<int> bufferNode; // node writing to each internal buffer
+	int threads = 0; // pool threads, in addition to host thread
+};
+
+/*
+ * Strings of plugin properties (names, labels, port names...), copied out
+ * of the master state, so it can be closed right after validation.
+ * Strings are never moved or freed while arena is alive.
+ */
+class StringArena {
+	std::vector<std::unique_ptr<char[]>> blocks;
+	size_t used = 0, size = 0; // in the last block
+	public:
+	const char* add(const char* s, size_t len);
+	const char* add(const char* s); // nullptr stays nullptr
+};
+
 struct PluginProperties {
-	/* makes it easy to reuse plugin as quick as possible */
-	std::string bytecode;
-	/* This lua state MUST BE KEEPED ALIVE DURING THE WHOLE USAGE
-	 * OF THIS PLUGIN TYPE!
-	 * (Strings below are used DIRECTLY from it.)
-	 * This desizion was made to simplify implementation
-	 */
-	LuaState  master;
+	/* makes it easy to reuse plugin as quick as possible.
+	 * Immutable, so instances (and chains) just reference it */
+	std::shared_ptr<const std::string> bytecode;
+	/* Master state is closed after loading, strings below live here */
+	StringArena strings;
 	
 	/*
 	 * We cache this values here just because accessing lua state
@@ -122,19 +212,222 @@ struct PluginProperties {
 	const char* label;
 	const char* maker;
 	const char* copyright;
+	unsigned long id = 0; // info.id (or 0 to use hash of the label)
 	bool        realtime;
+	int         oversample = 1; // run() at samplerate * oversample
+	int         latencyPort = -1; // output control port "latency" (or -1)
+	bool        worker = false; // start background worker for instances
+	size_t      async = 0; // run() block size in async thread (or 0)
+	int         strict = STRICT_OFF; // allocations in run() after warmup
+	bool        flushDenormals = true; // FTZ/DAZ around run()
+	size_t      warmup = 16; // run() blocks after activate() to ignore
+	int         poolSize = 2; // instances kept after cleanup() (info.pool)
+	bool        snapshot = false; // reuse without reset() (info.snapshot)
 	
-	// this array is maintained through uniqueptr, but strings in it
-	// are still from LuaState!	
+	// this array is maintained through uniqueptr, strings are in arena
 	std::unique_ptr<const char*[]> portNames;
 
 	// this is why ladspa sucks a bit... but it's not very critical.
 	std::unique_ptr<LADSPA_PortDescriptor[]> portDescriptors;
 	std::unique_ptr<LADSPA_PortRangeHint[]> portRangeHints;
 	size_t portCount;
+
+	// channel groups : port indices of each channel, for runChannel()
+	int channels = 0;
+	std::vector<std::vector<int>> channelPorts;
+
+	// chain plugin : stages run one after another (empty for usual plugin)
+	std::vector<ChainStage> stages;
+	size_t chainWidth = 0; // max number of audio links between two stages
+	std::unique_ptr<GraphLayout> graph; // graph plugin (or nullptr)
+
+	/*
+	 * Heavy readonly resources, prepared once per plugin type and shared
+	 * between all instances (impulse responses, wavetables and so on).
+	 * Keys are prefixed by resource kind, so types never mix.
+	 * Instances may be created from different threads, so lock it.
+	 */
+	std::mutex resLock;
+	std::map<std::string, std::shared_ptr<const void>> resources;
+
+	// pooled instances (they may use resources, so it's destroyed first)
+	InstancePoolPtr pool;
 };
 
-using PlugPropShared = std::shared_ptr<PluginProperties>;
+// Returns shared resource by key, or nullptr
+template <typename T>
+std::shared_ptr<const T> FindResource(PluginProperties* P,
+		const std::string& key) {
+	if (!P) return nullptr;
+	std::lock_guard<std::mutex> guard(P->resLock);
+	auto it = P->resources.find(key);
+	if (it == P->resources.end()) return nullptr;
+	return std::static_pointer_cast<const T>(it->second);
+}
+
+/*
+ * Returns shared resource by key, or makes it using maker().
+ * maker() may call lua (and throw), so it's called without a lock,
+ * and if someone was faster, his resource wins.
+ * Empty key means "do not cache".
+ */
+template <typename T, typename F>
+std::shared_ptr<const T> SharedResource(PluginProperties* P,
+		const std::string& key, F maker) {
+	if (!P || key.empty()) return maker();
+	{
+		std::lock_guard<std::mutex> guard(P->resLock);
+		auto it = P->resources.find(key);
+		if (it != P->resources.end())
+			return std::static_pointer_cast<const T>(it->second);
+	}
+	std::shared_ptr<const T> res = maker();
+	std::lock_guard<std::mutex> guard(P->resLock);
+	auto it = P->resources.emplace(key, res).first;
+	return std::static_pointer_cast<const T>(it->second);
+}
+
+/*
+ * Runs whole plugin at higher samplerate : audio inputs are upsampled
+ * into internal buffers before run(), outputs are decimated back after.
+ * Polyphase linear phase FIR filters (see oversampler.cpp).
+ */
+class Oversampler {
+	public:
+	Oversampler(int factor, size_t ports, const LADSPA_PortDescriptor* desc);
+	~Oversampler();
+	Oversampler(const Oversampler&) = delete;
+
+	// makes internal buffers big enough, returns block size for plugin
+	size_t prepare(size_t hostsamples);
+	// upsamples host input, returns internal buffer of the port
+	sample_type* upsample(size_t port, const sample_type* in, size_t n);
+	sample_type* buffer(size_t port);
+	// decimates internal buffer of the port into host output
+	void downsample(size_t port, sample_type* out, size_t n);
+	void reset();
+
+	int factor() const {return mFactor;}
+	size_t latency() const; // in host samples
+	private:
+	struct Channel;
+	size_t mFactor;
+	std::vector<float> mUp, mDown; // filter coefficients
+	std::vector<std::unique_ptr<Channel>> mChannels; // per port (audio only)
+};
+
+struct LadspaBuffer;
+
+/*
+ * Background worker thread with it's own lua state (see worker.cpp)
+ */
+class Worker;
+struct WorkerDeleter {
+	void operator()(Worker* W) const; // stops and joins thread
+};
+using WorkerPtr = std::unique_ptr<Worker, WorkerDeleter>;
+
+/*
+ * Runs non realtime plugin in separate thread with fixed latency
+ * (see async.cpp)
+ */
+class AsyncRunner;
+struct AsyncDeleter {
+	void operator()(AsyncRunner* A) const; // stops and joins thread
+};
+using AsyncPtr = std::unique_ptr<AsyncRunner, AsyncDeleter>;
+
+/*
+ * Messages from other threads (see messages.cpp and lualadspa_c.h)
+ */
+class MessageQueue;
+struct MessageQueueDeleter {
+	void operator()(MessageQueue* Q) const;
+};
+using MessageQueuePtr = std::unique_ptr<MessageQueue, MessageQueueDeleter>;
+
+/*
+ * Sets flush-to-zero and denormals-are-zero modes for current thread
+ * (subnormal numbers are very slow on most CPUs), and restores previous
+ * floating point state of the host on destruction.
+ */
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+class DenormalGuard {
+	unsigned int saved = 0;
+	bool active;
+	public:
+	DenormalGuard(bool enable) : active(enable) {
+		if (!active) return;
+		saved = _mm_getcsr();
+		_mm_setcsr(saved | 0x8040); // FTZ | DAZ
+	}
+	~DenormalGuard() {
+		if (active) _mm_setcsr(saved);
+	}
+};
+#elif defined(__aarch64__) && defined(__GNUC__)
+class DenormalGuard {
+	unsigned long saved = 0;
+	bool active;
+	public:
+	DenormalGuard(bool enable) : active(enable) {
+		if (!active) return;
+		saved = __builtin_aarch64_get_fpcr64();
+		__builtin_aarch64_set_fpcr64(saved | (1UL << 24)); // FZ
+	}
+	~DenormalGuard() {
+		if (active) __builtin_aarch64_set_fpcr64(saved);
+	}
+};
+#else
+class DenormalGuard { // no way to do it portably
+	public:
+	DenormalGuard(bool) {}
+};
+#endif
+
+class Telemetry;
+struct TelemetryDeleter {
+	void operator()(Telemetry* T) const;
+};
+using TelemetryPtr = std::unique_ptr<Telemetry, TelemetryDeleter>;
+
+/*
+ * Instance data of the chain plugin (see chain.cpp)
+ */
+class ChainState;
+struct ChainStateDeleter {
+	void operator()(ChainState* C) const;
+};
+using ChainStatePtr = std::unique_ptr<ChainState, ChainStateDeleter>;
+
+/*
+ * Instance data of the graph plugin : node instances and thread pool
+ */
+class GraphState;
+struct GraphStateDeleter {
+	void operator()(GraphState* G) const; // stops pool, destroys nodes
+};
+using GraphStatePtr = std::unique_ptr<GraphState, GraphStateDeleter>;
+
+/*
+ * Allocation in run() in strict log mode. It's copied by the audio
+ * thread, and logged later out of it (see memory.cpp)
+ */
+constexpr int max_strict_reports = 8; // per activation
+constexpr int max_report_frames = 6;
+struct AllocationReport {
+	size_t bytes;
+	bool denied;
+	bool traceback; // frames are known
+	int frames;
+	struct {
+		char source[64];
+		char name[32];
+		int line;
+	} frame[max_report_frames];
+};
 
 struct PluginHandle {
 	PlugPropShared P; // master (READONLY!!!)
@@ -143,8 +436,111 @@ struct PluginHandle {
 	unsigned long samplescnt;
 	bool shutdown; // is plugin TERMINATED
 	LuaState L; // plugin instance
+
+	// host data pointers. connect_port() does not touch lua state at all
+	std::unique_ptr<sample_type*[]> connected;
+	// port buffers (anchored in the registry "buffers" table)
+	std::unique_ptr<LadspaBuffer*[]> ports;
+	std::unique_ptr<Oversampler> oversampler; // if info.oversample > 1
+	size_t latency = 0; // set by plugin, in samples of plugin samplerate
+	size_t mainLatency = 0; // after main chunk, pooled instance gets it back
+	size_t errors = 0; // errors in plugin callbacks
+	size_t blocks = 0; // since activate()
+	// strict log mode reports since activate() (nullptr in other modes)
+	std::unique_ptr<AllocationReport[]> reports;
+	std::atomic<int> strictReports{0}; // made by run()
+	int reported = 0; // logged
+	// from info.flushDenormals by default, C API may set it from any thread
+	std::atomic<bool> flushDenormals{true};
+	// slot in shared memory (null if unavailable). Must outlive async thread
+	TelemetryPtr telemetry;
+	WorkerPtr worker; // if info.worker is set
+	AsyncPtr async; // if info.async is set
+	MessageQueuePtr messages; // for ladspa.pollMessages()
+	// held while host saves/loads state (see state.cpp), run() skips blocks
+	std::mutex stateLock;
+	ChainStatePtr chain; // if plugin is a chain
+	GraphStatePtr graph; // if plugin is a graph
 };
 
+/*
+ * Calls run() and runChannel() for the block, with ports connected to
+ * given data (host or async buffers)
+ */
+void ProcessBlock(PluginHandle* H, sample_type* const* connected,
+	unsigned long samplecount);
+
+// total latency of the plugin in host samples
+size_t PluginLatency(const PluginHandle* H);
+
+AsyncPtr NewAsyncRunner(PluginHandle* H);
+void StartAsync(PluginHandle* H); // on activate()
+void StopAsync(PluginHandle* H); // on deactivate()
+void RunAsync(PluginHandle* H, unsigned long samplecount);
+size_t AsyncLatency(const PluginHandle* H);
+
+MessageQueuePtr NewMessageQueue();
+// list of living instances for lualadspa_instances()
+void RegisterInstance(PluginHandle* H);
+void UnregisterInstance(PluginHandle* H);
+
+// loads plugin file and parses it's properties (nullptr on error).
+// Precompiled bytecode of the file may be given, to not compile it again
+PlugPropShared LoadPlugin(const char* name,
+	std::shared_ptr<const std::string> bytecode = nullptr);
+// new instance of the plugin (nullptr on error)
+PluginHandle* makeHandle(PlugPropShared props, unsigned long rate);
+
+/*
+ * Instance pool (see pool.cpp). PoolInstance() takes reset and
+ * deactivated instance after cleanup(), returns false if pool is full.
+ * TakeInstance() returns pooled instance with this samplerate (or nullptr)
+ */
+InstancePoolPtr NewInstancePool();
+bool PoolInstance(PluginHandle* H);
+PluginHandle* TakeInstance(PlugPropShared props, unsigned long rate);
+
+// copy of plugin data after main chunk, for plugins without reset()
+// (see snapshot.cpp). Both return false if it's not possible
+bool TakeSnapshot(PluginHandle* H);
+bool RestoreSnapshot(PluginHandle* H);
+
+// port description table, as in plugin ports (with "prefix: " in name)
+void PushPortDescription(lua_State* L, const PluginProperties* P,
+	size_t port, const char* prefix);
+
+/*
+ * Chain plugins (see chain.cpp). LoadChain() loads stages of the chain
+ * manifest in the master state and makes ports table for it.
+ * Both return false with error message on the stack.
+ */
+bool LoadChain(LuaState& L, PluginProperties* props, const char* name);
+bool LoadChainInstance(PluginHandle* H); // runs stages and makes buffers
+// pushes environment of the stage (and makes it current one)
+void PushStage(PluginHandle* H, size_t stage);
+// before run() of stages for samples from offset (parts are in order)
+void PrepareChain(PluginHandle* H, unsigned long offset,
+	unsigned long samplecount);
+void SetChainLatency(PluginHandle* H, size_t latency); // of current stage
+void RestoreChainLatency(PluginHandle* H); // to values after main chunks
+
+/*
+ * Graph plugins (see graph.cpp), the same way. Nodes are activated and
+ * deactivated by the host callbacks, with the graph.
+ */
+bool LoadGraph(LuaState& L, PluginProperties* props, const char* name);
+bool LoadGraphInstance(PluginHandle* H); // makes node instances
+size_t GraphNodeCount(const PluginHandle* H); // 0 if not a graph
+PluginHandle* GetGraphNode(PluginHandle* H, size_t i);
+void StartGraph(PluginHandle* H); // on activate(), starts thread pool
+void StopGraph(PluginHandle* H); // on deactivate()
+void RunGraph(PluginHandle* H, unsigned long samplecount);
+
+// takes free slot in telemetry segment (nullptr if not possible)
+TelemetryPtr NewTelemetry(PluginHandle* H);
+// publishes stats after block (samples = 0 just updates state)
+void PublishTelemetry(PluginHandle* H, unsigned long samples, double seconds);
+
 /*
  * Loads internal functions to the registry
  * + apply sandbox
@@ -162,24 +558,115 @@ void InitInstanceState(LuaState& L);
  */
 bool InitInstanceBuffers(lua_State* L, PluginHandle* H);
 
+/*
+ * Properties of the plugin type this state belongs to
+ * (valid for both master and instance states)
+ */
+PluginProperties* GetProperties(lua_State* L);
+void SetProperties(lua_State* L, PluginProperties* props);
+
+// samplerate of the instance (or some sane default for native objects
+// created in the master state)
+double GetSampleRate(lua_State* L);
+
+// instance handle (nullptr in the master state)
+PluginHandle* GetHandle(lua_State* L);
+
 struct LadspaBuffer {
 	sample_type* buffer;
-	size_t size   : 63;
+	size_t size   : 62;
 	bool external :  1;
+	bool readonly :  1; // shared data (always external too)
 };
 
 LadspaBuffer* NewBuffer(lua_State* L, bool external);
+LadspaBuffer* CheckBuffer(lua_State* L, int idx);
+LadspaBuffer* CheckOutBuffer(lua_State* L, int idx); // + not readonly
+LadspaBuffer* AllocBuffer(lua_State* L, size_t n); // new internal buffer
+// resizes internal buffer (size 0 keeps it as is, as ladspa.resizeBuffer)
+void ResizeBuffer(lua_State* L, LadspaBuffer* B, size_t n);
+
+// registers metatable for native object with methods in __index
+void NewClass(lua_State* L, const char* name, const luaL_Reg* methods);
+
+// lua state of the whole VM (works for coroutines too)
+static inline LuaState& GetLuaState(lua_State* L) {
+	return *reinterpret_cast<LuaState*>(lua_getthreaddata(lua_mainthread(L)));
+}
 
 // custom libs
 void OpenInternals(lua_State* L);
 void OpenLuaLadspa(lua_State* L);
+void OpenLuaFFT(lua_State* L); // adds to ladspa library
+void OpenLuaOscillator(lua_State* L); // same
+void OpenLuaDynamics(lua_State* L); // same
+void OpenLuaWorker(lua_State* L); // same
+void OpenLuaMessages(lua_State* L);
+void OpenLuaMemory(lua_State* L);
+
+// strict mode (see memory.cpp)
+void BeginStrictBlock(PluginHandle* H);
+void EndStrictBlock(PluginHandle* H);
+// makes report of pending strict mode violation, with traceback of L
+// (if not null). Called by run(), so it doesn't format or log anything
+void ReportAllocation(PluginHandle* H, lua_State* L);
+// logs reports made since the last call (never call it in run())
+void LogAllocations(PluginHandle* H);
+// measures lua GC step (called before and after each one)
+void TelemetryGC(PluginHandle* H); // same
+
+// starts worker thread for the instance (after main chunk)
+WorkerPtr StartWorker(PluginHandle* H);
+// delivers worker results to onWorkDone()/onWorkError()
+void PollWorker(PluginHandle* H);
 
-// modules/database api
-extern "C" void refreshDatabase();
-
-// already precompiled modules
-const std::string& loadModule(const char* id);
-const char* modulesNameIterator(long int idx);
+/*
+ * Plugin database (see database.cpp) : what is known about each plugin
+ * file since it was loaded last time, so it's not loaded again until it
+ * (or any file it loads) is changed.
+ */
+struct FileStamp {
+	static constexpr uint64_t missing = ~0ull; // size of file, that must not
+	                                           // appear (module shadowing)
+	std::string file;
+	int64_t mtime = 0;
+	uint64_t size = 0;
+};
 
-// where to search for new modules?
+struct PluginRecord {
+	std::vector<FileStamp> files; // plugin file first, then it's dependencies
+	uint64_t hash = 0; // of plugin file source
+	std::string error; // of the last load (empty if plugin is fine)
+	// properties of the plugin, for the descriptor
+	std::string label, name, maker, copyright;
+	unsigned long id = 0; // info.id
+	bool realtime = false;
+	std::vector<std::string> portNames;
+	std::vector<LADSPA_PortDescriptor> portDescriptors;
+	std::vector<LADSPA_PortRangeHint> portRangeHints;
+	std::shared_ptr<const std::string> bytecode;
+	uint64_t checksum = 0; // of the bytecode
+};
+using PluginDatabase = std::map<std::string, PluginRecord>; // by file
+
+PluginDatabase ReadDatabase(const std::string& file); // empty if it's bad
+void WriteDatabase(const std::string& file, const PluginDatabase& db);
+// loads plugin, and makes record of it (props are nullptr on error)
+PluginRecord ScanPlugin(const std::string& file, PlugPropShared& props);
+uint64_t BytecodeChecksum(const std::string& bytecode); // 64 bit FNV-1a
+// are files of the record unchanged? (touched is set, if record is updated)
+bool IsRecordFresh(PluginRecord& R, bool& touched);
+// notes file loaded by plugin (with source, if it's plugin file), or
+// file it tried to load : record is fresh only while it's missing
+void TraceFile(const char* file, const std::string* source = nullptr);
+void TraceError(const std::string& error); // last error of LoadPlugin()
+// writes a copy of the file, and replaces the file with it
+bool ReplaceFile(const std::string& file, const std::string& data);
+
+// require() (see modules.cpp)
+void OpenLuaModules(lua_State* L);
+
+// where to search for modules? (home path first, nullptr after the last)
 const char* searchPathesIterator(long int idx);
+// directory for index and caches (nullptr if unknown)
+const char* cacheDirectory();
@@ -0,0 +1,187 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * C API of liblualadspa for hosts and controller tools.
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LUALADSPA_C_H
+#define LUALADSPA_C_H
+
+#include "ladspa.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Messages. Any thread may post small messages into plugin instance,
+ * and plugin receives them in run() through ladspa.pollMessages().
+ * Posting never blocks audio thread and never allocates.
+ * All functions return 1 on success, and 0 if queue is full (or
+ * message is too big, or instance is already cleaned up).
+ * Handle is checked against living instances, so posting after cleanup()
+ * is safe, but host may give the same address to a new instance : stop
+ * posting to the instance when host cleans it up, or take handles from
+ * lualadspa_instances() each time.
+ */
+
+/* maximal size of string/blob message payload in bytes */
+#define LUALADSPA_MESSAGE_MAX 240
+
+int lualadspa_post_number(LADSPA_Handle instance, uint32_t id, double value);
+int lualadspa_post_string(LADSPA_Handle instance, uint32_t id,
+	const char* str, size_t len);
+int lualadspa_post_blob(LADSPA_Handle instance, uint32_t id,
+	const float* data, size_t count);
+
+/*
+ * Calls callback for each living instance of plugin with this label
+ * (or for all instances, if label is NULL). Instances can't be destroyed
+ * while callback is running, but you must not keep the handle after.
+ * Returns number of instances.
+ */
+typedef void (*lualadspa_instance_cb)(LADSPA_Handle instance,
+	const char* label, void* userdata);
+size_t lualadspa_instances(const char* label, lualadspa_instance_cb cb,
+	void* userdata);
+
+/*
+ * Flush-to-zero/denormals-are-zero mode around run() (default is
+ * info.flushDenormals of the plugin, which is on by default).
+ */
+void lualadspa_set_flush_denormals(LADSPA_Handle instance, int enable);
+
+/*
+ * Errors in plugin callbacks (run(), activate()...) since instantiate(),
+ * and 1 in terminated, if plugin was shut down (it outputs silence then).
+ * Graph plugins count errors of all their nodes.
+ * Returns 0 if instance is NULL.
+ */
+int lualadspa_errors(LADSPA_Handle instance, uint64_t* errors,
+	int* terminated);
+
+/*
+ * Memory stats of instance lua state (see ladspa.getMemoryStats()).
+ * Counters are updated by the thread running the instance without locks,
+ * so values may be a bit inconsistent if it's running right now.
+ * Returns 0 if handle is NULL.
+ */
+struct lualadspa_memory_stats {
+	uint64_t used;            /* bytes allocated now */
+	uint64_t limit;
+	uint64_t peak;            /* high-water mark of used */
+	uint64_t heap;            /* lua objects (used - buffers) */
+	uint64_t buffers;         /* storage of ladspa buffers */
+	uint64_t allocations;     /* new blocks and growing reallocations */
+	uint64_t frees;
+	uint64_t bytes;           /* total allocated bytes */
+	uint64_t largest;         /* largest single block */
+	uint64_t failed;          /* allocations denied by the limit */
+	uint64_t run_allocations; /* allocations inside run() */
+	uint64_t run_bytes;
+	uint64_t strict_violations; /* allocations in run() after warmup */
+};
+int lualadspa_memory_stats(LADSPA_Handle instance,
+	struct lualadspa_memory_stats* out);
+
+/*
+ * Plugin state (presets). State is what saveState() hook of the plugin
+ * returns (for each stage of chain and each node of graph), host may
+ * keep it anywhere and give it back later to loadState(state).
+ * Call them from any thread except audio one : run() outputs silence
+ * while state is saved or loaded, instead of waiting.
+ * lualadspa_save_state() returns binary blob (free it with
+ * lualadspa_free_state()), or NULL on error. lualadspa_load_state()
+ * returns 1 on success, and 0 on error (or if state is of other plugin).
+ */
+void* lualadspa_save_state(LADSPA_Handle instance, size_t* size);
+void lualadspa_free_state(void* state);
+int lualadspa_load_state(LADSPA_Handle instance, const void* data,
+	size_t size);
+
+/*
+ * Catalog of plugin files (from plugin database), for tools like
+ * lualadspa list. Callback gets each plugin file (and each slot of
+ * removed plugin, with NULL file). Strings are valid during the call.
+ * Returns number of entries.
+ */
+struct lualadspa_plugin_info {
+	const char* file;
+	const char* label;    /* NULL if plugin can't be loaded */
+	const char* name;
+	unsigned long id;
+	unsigned long ports;
+	long index;           /* for ladspa_descriptor(), -1 if there is none */
+	const char* error;    /* why it's not available (NULL if it is) */
+};
+typedef void (*lualadspa_plugin_cb)(const struct lualadspa_plugin_info* info,
+	void* userdata);
+size_t lualadspa_plugins(lualadspa_plugin_cb cb, void* userdata);
+
+/*
+ * Telemetry. Each process publishes stats of it's instances into POSIX
+ * shared memory segment LUALADSPA_TELEMETRY_PREFIX + pid (/dev/shm on
+ * Linux), with fixed layout below. Every slot is protected by seqlock :
+ * writer makes seq odd, updates slot and makes seq even again, so reader
+ * must retry if seq was odd or changed while copying.
+ * Not available on Windows.
+ */
+
+#define LUALADSPA_TELEMETRY_PREFIX "/lualadspa."
+#define LUALADSPA_TELEMETRY_MAGIC 0x54534c4c /* "LLST" */
+#define LUALADSPA_TELEMETRY_VERSION 2
+#define LUALADSPA_TELEMETRY_SLOTS 128
+#define LUALADSPA_LABEL_MAX 48
+
+/* run() time histogram : bucket k counts blocks that took less than
+ * 2^((k+1)/2) microseconds (the last one counts all slower blocks) */
+#define LUALADSPA_TELEMETRY_BUCKETS 32
+
+struct lualadspa_stats {
+	uint32_t seq;
+	uint32_t active;     /* slot is used by living instance */
+	uint64_t id;         /* instance id, unique in the process */
+	char label[LUALADSPA_LABEL_MAX];
+	uint32_t samplerate;
+	uint32_t shutdown;   /* instance is terminated after fatal error */
+	uint64_t blocks;
+	uint64_t samples;
+	uint64_t errors;     /* errors in plugin callbacks */
+	uint64_t memory;     /* lua memory used, bytes */
+	uint64_t memory_limit;
+	uint64_t memory_peak;
+	uint64_t run_allocations; /* allocations inside run() */
+	uint64_t run_bytes;
+	double run_time;     /* seconds spent in run(), total */
+	double gc_time;      /* seconds spent in lua GC, total */
+	uint64_t run_hist[LUALADSPA_TELEMETRY_BUCKETS];
+};
+
+struct lualadspa_telemetry {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t pid;
+	uint32_t slots;
+	struct lualadspa_stats stats[LUALADSPA_TELEMETRY_SLOTS];
+};
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,229 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Memory statistics of plugin lua states
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "lualadspa_c.h"
+
+/*
+ * Counters are kept by LuaState::limalloc() (see instance.cpp), this
+ * file only exposes them.
+ */
+
+extern "C" int lualadspa_memory_stats(LADSPA_Handle instance,
+		struct lualadspa_memory_stats* out) {
+	PluginHandle* H = reinterpret_cast<PluginHandle*>(instance);
+	if (!H || !out) return 0;
+	const auto& A = H->L.allocdata;
+	out->used = A.allocated;
+	out->limit = A.maxlimit;
+	out->peak = A.peak;
+	out->heap = A.allocated - A.buffers;
+	out->buffers = A.buffers;
+	out->allocations = A.allocations;
+	out->frees = A.frees;
+	out->bytes = A.bytes;
+	out->largest = A.largest;
+	out->failed = A.failed;
+	out->run_allocations = A.runAllocations;
+	out->run_bytes = A.runBytes;
+	out->strict_violations = A.strictViolations;
+	return 1;
+}
+
+/*
+ * Strict mode : after warmup, allocations in run() are counted (and
+ * denied) by limalloc(). Traceback can't be made right in the allocator,
+ * so it's copied on the next interrupt (call or loop back edge), or after
+ * the block without it. Reports are logged by deactivate() and cleanup() :
+ * formatting and writing the log would be the same realtime violation.
+ */
+
+void BeginStrictBlock(PluginHandle* H) {
+	auto& A = H->L.allocdata;
+	A.strict = H->blocks >= H->P->warmup ? H->P->strict : STRICT_OFF;
+	A.pending = false;
+	A.denied = false;
+	H->blocks++;
+}
+
+void EndStrictBlock(PluginHandle* H) {
+	auto& A = H->L.allocdata;
+	if (A.pending) ReportAllocation(H, nullptr);
+	A.strict = STRICT_OFF;
+}
+
+// strncpy() without padding, and nullptr is empty string
+template <size_t N>
+static void copyString(char (&dst)[N], const char* src) {
+	size_t i = 0;
+	for (; src && src[i] && i < N - 1; i++) dst[i] = src[i];
+	dst[i] = 0;
+}
+
+void ReportAllocation(PluginHandle* H, lua_State* L) {
+	auto& A = H->L.allocdata;
+	A.pending = false;
+	const int n = H->strictReports.load(std::memory_order_relaxed);
+	if (A.strict < STRICT_LOG || !H->reports || n >= max_strict_reports) return;
+
+	AllocationReport& R = H->reports[n];
+	R.bytes = A.lastViolation;
+	R.denied = A.denied;
+	R.traceback = L != nullptr;
+	R.frames = 0;
+	lua_Debug ar; // lua_debugtrace() is not thread safe
+	for (int level = 0; L && R.frames < max_report_frames &&
+			lua_getinfo(L, level, "sln", &ar); level++) {
+		auto& F = R.frame[R.frames++];
+		copyString(F.source, ar.short_src);
+		copyString(F.name, ar.name);
+		F.line = ar.currentline;
+	}
+	H->strictReports.store(n + 1, std::memory_order_release);
+}
+
+void LogAllocations(PluginHandle* H) {
+	const int n = H->strictReports.load(std::memory_order_acquire);
+	for (; H->reported < n; H->reported++) {
+		const AllocationReport& R = H->reports[H->reported];
+		std::string trace;
+		for (int i = 0; i < R.frames; i++) {
+			auto& F = R.frame[i];
+			trace += strformat("\n\t%s:%i%s%s", F.source, F.line,
+				F.name[0] ? " function " : "", F.name);
+		}
+		logError("Plugin %s allocated %i bytes in run()%s%s%s", H->P->name,
+			(int)R.bytes, R.denied ? " (denied)" : "",
+			R.traceback ? ", at :" : ", no traceback", trace.c_str());
+		if (H->reported + 1 == max_strict_reports)
+			logError("Plugin %s : further allocations are only counted", H->P->name);
+	}
+}
+
+static void setField(lua_State* L, const char* k, size_t v) {
+	lua_pushnumber(L, (double)v);
+	lua_setfield(L, -2, k);
+}
+
+// ladspa.getMemoryStats([table]) -> table (given table is reused)
+static int lmem_stats(lua_State* LL) {
+	const auto& A = GetLuaState(LL).allocdata;
+	if (lua_istable(LL, 1)) lua_settop(LL, 1);
+	else lua_createtable(LL, 0, 13);
+	setField(LL, "used", A.allocated);
+	setField(LL, "limit", A.maxlimit);
+	setField(LL, "peak", A.peak);
+	setField(LL, "heap", A.allocated - A.buffers);
+	setField(LL, "buffers", A.buffers);
+	setField(LL, "allocations", A.allocations);
+	setField(LL, "frees", A.frees);
+	setField(LL, "bytes", A.bytes);
+	setField(LL, "largest", A.largest);
+	setField(LL, "failed", A.failed);
+	setField(LL, "runAllocations", A.runAllocations);
+	setField(LL, "runBytes", A.runBytes);
+	setField(LL, "strictViolations", A.strictViolations);
+	return 1;
+}
+
+/*
+ * ladspa.countObjects() -> table of reachable objects by type.
+ * Walks everything reachable from the registry, so it's slow and
+ * allocates : never call it in run()!
+ */
+static int lmem_count(lua_State* L) {
+	lua_settop(L, 0);
+	lua_newtable(L); // 1 : seen objects
+	lua_newtable(L); // 2 : queue
+	int head = 1, tail = 0;
+	size_t counts[LUA_T_COUNT] = {0};
+	size_t buffers = 0, strbytes = 0;
+
+	auto add = [&] (int idx) {
+		const int t = lua_type(L, idx);
+		if (t < LUA_TSTRING || t >= LUA_T_COUNT) return; // not collectable
+		lua_pushvalue(L, idx);
+		lua_rawget(L, 1);
+		const bool seen = !lua_isnil(L, -1);
+		lua_pop(L, 1);
+		if (seen) return;
+		lua_pushvalue(L, idx);
+		lua_pushboolean(L, 1);
+		lua_rawset(L, 1);
+		lua_pushvalue(L, idx);
+		lua_rawseti(L, 2, ++tail);
+	};
+
+	luaL_getmetatable(L, "_bufferMT"); // 3 : to find buffers
+	lua_pushvalue(L, LUA_REGISTRYINDEX);
+	add(4);
+	lua_pushvalue(L, LUA_GLOBALSINDEX);
+	add(5);
+	lua_settop(L, 3);
+
+	while (head <= tail) {
+		lua_rawgeti(L, 2, head++);
+		const int v = lua_gettop(L);
+		const int t = lua_type(L, v);
+		counts[t]++;
+		if (t != LUA_TSTRING && lua_getmetatable(L, v)) {
+			if (t == LUA_TUSERDATA && lua_rawequal(L, v + 1, 3)) buffers++;
+			add(v + 1);
+			lua_pop(L, 1);
+		}
+		switch (t) {
+		case LUA_TSTRING: strbytes += lua_objlen(L, v); break;
+		case LUA_TTABLE:
+			lua_pushnil(L);
+			while (lua_next(L, v)) {
+				add(v + 1);
+				add(v + 2);
+				lua_pop(L, 1);
+			}
+			break;
+		case LUA_TFUNCTION:
+			for (int i = 1; lua_getupvalue(L, v, i); i++) {
+				add(v + 1);
+				lua_pop(L, 1);
+			}
+			lua_getfenv(L, v);
+			add(v + 1);
+			break;
+		}
+		lua_settop(L, 3);
+	}
+
+	lua_createtable(L, 0, LUA_T_COUNT);
+	for (int t = LUA_TSTRING; t < LUA_T_COUNT; t++)
+		setField(L, lua_typename(L, t), counts[t]);
+	setField(L, "buffer", buffers);
+	setField(L, "stringBytes", strbytes);
+	return 1;
+}
+
+static const luaL_Reg memory_funcs[] = {
+	{"getMemoryStats", lmem_stats},
+	{"countObjects", lmem_count},
+	{nullptr, nullptr}
+};
+
+void OpenLuaMemory(lua_State* L) {
+	luaL_register(L, "ladspa", memory_funcs);
+	lua_pop(L, 1);
+}
@@ -0,0 +1,212 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Messages from other threads into plugin instances
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "lualadspa_c.h"
+#include "queue.hpp"
+#include <algorithm>
+#include <cstring>
+#include <thread>
+
+/*
+ * Fixed size messages in preallocated ring. Consumer (run()) is lock
+ * free, producers are serialized by spinlock (they are never realtime).
+ */
+constexpr size_t message_queue_size = 64;
+
+enum MessageKind : uint32_t {
+	MSG_NUMBER = 0,
+	MSG_STRING,
+	MSG_BLOB
+};
+
+struct Message {
+	uint32_t id;
+	uint32_t kind;
+	uint32_t size; // bytes of string/blob
+	union {
+		double number;
+		char bytes[LUALADSPA_MESSAGE_MAX];
+		float blob[LUALADSPA_MESSAGE_MAX / sizeof(float)];
+	};
+};
+
+class MessageQueue {
+	public:
+	SPSCQueue<Message, message_queue_size> queue;
+	std::atomic_flag producer = ATOMIC_FLAG_INIT;
+	bool delivered = false; // front message is given to lua already
+
+	template <typename F>
+	bool post(F fill) {
+		while (producer.test_and_set(std::memory_order_acquire))
+			std::this_thread::yield();
+		Message* m = queue.back();
+		if (m) {
+			fill(*m);
+			queue.push();
+		}
+		producer.clear(std::memory_order_release);
+		return m;
+	}
+};
+
+void MessageQueueDeleter::operator()(MessageQueue* Q) const {
+	delete Q;
+}
+
+MessageQueuePtr NewMessageQueue() {
+	return MessageQueuePtr(new MessageQueue);
+}
+
+/*
+ * Living instances (for controllers). Posting holds the lock, so instance
+ * can't be unregistered (and destroyed) in the middle. It's recursive :
+ * controllers post from lualadspa_instances() callback.
+ */
+
+static std::recursive_mutex instancesLock;
+static std::vector<PluginHandle*> instances;
+
+void RegisterInstance(PluginHandle* H) {
+	std::lock_guard<std::recursive_mutex> guard(instancesLock);
+	instances.push_back(H);
+}
+
+void UnregisterInstance(PluginHandle* H) {
+	std::lock_guard<std::recursive_mutex> guard(instancesLock);
+	instances.erase(std::remove(instances.begin(), instances.end(), H),
+		instances.end());
+}
+
+/*
+ * C API
+ */
+
+// queue of living instance (nullptr for destroyed or pooled one)
+static MessageQueue* getQueue(LADSPA_Handle instance) {
+	PluginHandle* H = reinterpret_cast<PluginHandle*>(instance);
+	if (std::find(instances.begin(), instances.end(), H) == instances.end())
+		return nullptr;
+	return H->messages.get();
+}
+
+extern "C" int lualadspa_post_number(LADSPA_Handle instance, uint32_t id,
+		double value) {
+	std::lock_guard<std::recursive_mutex> guard(instancesLock);
+	MessageQueue* Q = getQueue(instance);
+	return Q && Q->post([&] (Message& m) {
+		m.id = id;
+		m.kind = MSG_NUMBER;
+		m.size = 0;
+		m.number = value;
+	});
+}
+
+static int postBytes(LADSPA_Handle instance, uint32_t id, uint32_t kind,
+		const void* data, size_t size) {
+	std::lock_guard<std::recursive_mutex> guard(instancesLock);
+	MessageQueue* Q = getQueue(instance);
+	if (!Q || size > LUALADSPA_MESSAGE_MAX) return 0;
+	return Q->post([&] (Message& m) {
+		m.id = id;
+		m.kind = kind;
+		m.size = size;
+		if (size) std::memcpy(m.bytes, data, size);
+	});
+}
+
+extern "C" int lualadspa_post_string(LADSPA_Handle instance, uint32_t id,
+		const char* str, size_t len) {
+	return postBytes(instance, id, MSG_STRING, str, len);
+}
+
+extern "C" int lualadspa_post_blob(LADSPA_Handle instance, uint32_t id,
+		const float* data, size_t count) {
+	return postBytes(instance, id, MSG_BLOB, data, count * sizeof(float));
+}
+
+extern "C" size_t lualadspa_instances(const char* label,
+		lualadspa_instance_cb cb, void* userdata) {
+	std::lock_guard<std::recursive_mutex> guard(instancesLock);
+	size_t n = 0;
+	for (PluginHandle* H : instances) {
+		if (label && std::strcmp(label, H->P->label) != 0) continue;
+		if (cb) cb(H, H->P->label, userdata);
+		n++;
+	}
+	return n;
+}
+
+/*
+ * Lua API
+ */
+
+// iterator : returns id, value of the next message
+static int lmsg_next(lua_State* L) {
+	PluginHandle* H = GetHandle(L);
+	if (!H) return 0;
+	MessageQueue* Q = H->messages.get();
+	if (Q->delivered) { // previous one is not needed anymore
+		Q->queue.pop();
+		Q->delivered = false;
+	}
+	Message* m = Q->queue.front();
+	if (!m) return 0;
+	Q->delivered = true;
+
+	lua_pushinteger(L, m->id);
+	switch (m->kind) {
+	case MSG_NUMBER:
+		lua_pushnumber(L, m->number);
+		break;
+	case MSG_STRING:
+		lua_pushlstring(L, m->bytes, m->size);
+		break;
+	default: { // blob : the same readonly view is reused for all of them
+		lua_getfield(L, LUA_REGISTRYINDEX, "msgview");
+		LadspaBuffer* B;
+		if (lua_isnil(L, -1)) {
+			lua_pop(L, 1);
+			B = NewBuffer(L, true);
+			lua_pushvalue(L, -1);
+			lua_setfield(L, LUA_REGISTRYINDEX, "msgview");
+		} else B = CheckBuffer(L, -1);
+		B->buffer = m->blob;
+		B->size = m->size / sizeof(float);
+		B->readonly = true;
+		break;
+	}
+	}
+	return 2;
+}
+
+// for id, value in ladspa.pollMessages() do ... end
+static int lmsg_poll(lua_State* L) {
+	lua_pushvalue(L, lua_upvalueindex(1)); // no allocations
+	return 1;
+}
+
+void OpenLuaMessages(lua_State* L) {
+	lua_getfield(L, LUA_GLOBALSINDEX, "ladspa");
+	lua_pushcfunction(L, lmsg_next, "nextMessage");
+	lua_pushcclosure(L, lmsg_poll, "pollMessages", 1);
+	lua_setfield(L, -2, "pollMessages");
+	lua_pop(L, 1);
+}
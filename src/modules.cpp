@@ -0,0 +1,244 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Modules for require() and their bytecode cache
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "fileIO.hpp"
+#include <cstring>
+
+/*
+ * require("dsp.filters") loads lib/dsp/filters.lua from the plugin
+ * search pathes (home one first). Module is compiled once per library
+ * load, and it's bytecode is shared by all lua states (master, instances,
+ * chain stages, workers). Bytecode is also kept in the cache directory
+ * by hash of the source, so next host start does not compile it again.
+ * Cached file starts with checksum of the bytecode (64 bit FNV-1a), and
+ * damaged one is compiled again.
+ *
+ * Module runs once per lua state, in globals of the state, and it's
+ * result is kept in registry "modules" table. Pure data (tables of
+ * numbers, strings and booleans only) is frozen, so all stages share
+ * it readonly, and snapshot of pooled instances does not copy it.
+ */
+constexpr char module_cache_version[] = "lualadspa modules 2";
+constexpr size_t module_name_max = 128;
+
+struct Module {
+	std::string file; // where it was found
+	std::vector<std::string> shadows; // missing files before it
+	std::shared_ptr<const std::string> bytecode;
+};
+
+static std::mutex modulesLock;
+// name path -> module (for this library load)
+static std::map<std::string, Module> modules;
+
+// 64 bit FNV-1a
+static uint64_t hashData(const char* data, size_t len, uint64_t h =
+		14695981039346656037ull) {
+	for (size_t i = 0; i < len; i++) {
+		h ^= (unsigned char)data[i];
+		h *= 1099511628211ull;
+	}
+	return h;
+}
+
+static bool readFile(const fsys::path& file, std::string& out) {
+	FileIO f;
+	if (!f.open(file, "rb")) return false;
+	f.seek(0, FileIO::SeekBase::END);
+	auto len = f.tell();
+	f.rewind();
+	return len >= 0 && f.read(out, len) && f;
+}
+
+// "dsp.filters" -> "dsp/filters.lua", empty if name is bad
+static std::string modulePath(const char* name) {
+	std::string path;
+	bool dot = true; // no empty parts
+	for (const char* c = name; *c; c++) {
+		if (*c == '.') {
+			if (dot) return "";
+			path += '/';
+			dot = true;
+			continue;
+		}
+		if (!isalnum((unsigned char)*c) && *c != '_' && *c != '-') return "";
+		path += *c;
+		dot = false;
+	}
+	if (dot || path.size() > module_name_max) return "";
+	return path + ".lua";
+}
+
+// the first one in search pathes. Files, that would shadow it, are missed
+static fsys::path findModule(const std::string& path,
+		std::vector<std::string>& missed) {
+	std::error_code ec;
+	for (long i = 0; const char* dir = searchPathesIterator(i); i++) {
+		fsys::path file = fsys::path(dir) / "lib" / path;
+		if (fsys::is_regular_file(file, ec)) return file;
+		missed.push_back(file.string());
+	}
+	return {};
+}
+
+/*
+ * Bytecode of the module (nullptr if there is no such module).
+ * Compilation errors are in the bytecode too, as luau does it.
+ * Fresh one is compiled again, without any caches.
+ */
+static std::shared_ptr<const std::string> moduleBytecode(const char* name,
+		bool fresh = false) {
+	const std::string path = modulePath(name);
+	if (path.empty()) return nullptr;
+	std::lock_guard<std::mutex> guard(modulesLock);
+	auto it = modules.find(path);
+	if (it != modules.end() && !fresh) {
+		TraceFile(it->second.file.c_str()); // plugin depends on it
+		for (auto& f : it->second.shadows) TraceFile(f.c_str()); // and on them
+		return it->second.bytecode;
+	}
+
+	std::vector<std::string> shadows;
+	fsys::path file = findModule(path, shadows);
+	// missing files are traced too : plugin is loaded again, when they appear
+	for (auto& f : shadows) TraceFile(f.c_str());
+	std::string source, bytecode;
+	if (file.empty() || !readFile(file, source)) return nullptr;
+	TraceFile(file.string().c_str());
+	uint64_t hash = hashData(module_cache_version, sizeof(module_cache_version));
+	hash = hashData(source.data(), source.size(), hash);
+	fsys::path cached;
+	if (const char* dir = cacheDirectory())
+		cached = fsys::path(dir) / "modules" / strformat("%016llx.luauc",
+			(unsigned long long)hash);
+	// bytecode starts with version byte, 0 is compilation error
+	std::string data;
+	uint64_t checksum = 0;
+	if (!fresh && !cached.empty() && readFile(cached, data) &&
+			data.size() > sizeof(checksum)) {
+		std::memcpy(&checksum, data.data(), sizeof(checksum));
+		bytecode = data.substr(sizeof(checksum));
+		if (!bytecode[0] || hashData(bytecode.data(), bytecode.size()) != checksum) {
+			logError("Cached bytecode of module %s is damaged!", name);
+			bytecode.clear();
+		}
+	}
+	if (bytecode.empty()) {
+		LuaState::compileCode(source.data(), source.size(), bytecode);
+		if (!cached.empty() && !bytecode.empty() && bytecode[0]) {
+			checksum = hashData(bytecode.data(), bytecode.size());
+			data.assign(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+			ReplaceFile(cached.string(), data + bytecode); // it's just a cache
+		}
+	}
+	auto res = std::make_shared<const std::string>(std::move(bytecode));
+	modules[path] = {file.string(), std::move(shadows), res};
+	return res;
+}
+
+// only numbers, strings, booleans and tables of them?
+static bool isPureData(lua_State* L, int idx, int depth) {
+	if (depth > 32 || !lua_checkstack(L, 3)) return false;
+	bool pure = true;
+	lua_pushnil(L);
+	while (pure && lua_next(L, idx)) {
+		for (int i = -2; i <= -1 && pure; i++) {
+			switch (lua_type(L, i)) {
+			case LUA_TNUMBER: case LUA_TSTRING: case LUA_TBOOLEAN: break;
+			case LUA_TTABLE:
+				pure = !lua_getmetatable(L, i);
+				if (!pure) lua_pop(L, 1);
+				else pure = isPureData(L, lua_gettop(L) + i + 1, depth + 1);
+				break;
+			default: pure = false;
+			}
+		}
+		lua_pop(L, 1);
+	}
+	if (!pure) lua_pop(L, 1); // key
+	return pure;
+}
+
+static void freezeData(lua_State* L, int idx) {
+	if (lua_getreadonly(L, idx)) return;
+	lua_setreadonly(L, idx, true);
+	lua_pushnil(L);
+	while (lua_next(L, idx)) {
+		if (lua_istable(L, -2)) freezeData(L, lua_gettop(L) - 1);
+		if (lua_istable(L, -1)) freezeData(L, lua_gettop(L));
+		lua_pop(L, 1);
+	}
+}
+
+static const char loading = 0; // marker of module being loaded
+
+// require(name) -> result of the module
+static int lmod_require(lua_State* L) {
+	const char* name = luaL_checkstring(L, 1);
+	lua_settop(L, 1);
+	lua_getfield(L, LUA_REGISTRYINDEX, "modules");
+	lua_pushvalue(L, 1);
+	switch (lua_rawget(L, 2)) {
+	case LUA_TNIL: break;
+	case LUA_TLIGHTUSERDATA: luaL_error(L, "module %s requires itself", name);
+	default: return 1;
+	}
+	lua_pop(L, 1);
+	// loading reads files and compiles under the lock : never on audio thread
+	if (GetLuaState(L).allocdata.inRun)
+		luaL_error(L, "module %s is not loaded, require() can't load it in run()",
+			name);
+	auto bytecode = moduleBytecode(name);
+	if (!bytecode) luaL_error(L, "module %s not found", name);
+	if (luau_load(L, name, bytecode->data(), bytecode->size(), 0) != LUA_OK) {
+		if (bytecode->empty() || !(*bytecode)[0]) lua_error(L); // syntax error
+		lua_pop(L, 1); // cached by other luau version?
+		bytecode = moduleBytecode(name, true);
+		if (!bytecode || luau_load(L, name, bytecode->data(), bytecode->size(),
+			0) != LUA_OK) lua_error(L);
+	}
+	lua_pushvalue(L, 1);
+	lua_pushlightuserdata(L, (void*)&loading);
+	lua_rawset(L, 2);
+	if (lua_pcall(L, 0, 1, 0) != LUA_OK) {
+		lua_pushvalue(L, 1);
+		lua_pushnil(L);
+		lua_rawset(L, 2);
+		lua_error(L);
+	}
+	if (lua_isnil(L, -1)) {
+		lua_pop(L, 1);
+		lua_pushboolean(L, 1);
+	}
+	if (lua_istable(L, -1) && !lua_getmetatable(L, -1) &&
+			isPureData(L, lua_gettop(L), 0))
+		freezeData(L, lua_gettop(L));
+	lua_pushvalue(L, 1);
+	lua_pushvalue(L, -2);
+	lua_rawset(L, 2);
+	return 1;
+}
+
+void OpenLuaModules(lua_State* L) {
+	lua_newtable(L);
+	lua_setfield(L, LUA_REGISTRYINDEX, "modules");
+	lua_pushcfunction(L, lmod_require, "require");
+	lua_setfield(L, LUA_GLOBALSINDEX, "require");
+}
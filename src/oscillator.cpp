@@ -0,0 +1,248 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Native audio rate oscillators (band limited and wavetable ones)
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include <cmath>
+#include <cstring>
+#include <new>
+
+#define OSCNAME "_oscillatorMT"
+
+/*
+ * Wavetable is a single cycle of the waveform + one guard sample
+ * for interpolation. Readonly, shared between instances.
+ */
+struct Wavetable {
+	size_t size;
+	std::unique_ptr<float[]> data; // size + 1
+};
+
+using WavetableShared = std::shared_ptr<const Wavetable>;
+
+static WavetableShared makeWavetable(const sample_type* src, size_t n) {
+	auto W = std::make_shared<Wavetable>();
+	W->size = n;
+	W->data = std::make_unique<float[]>(n + 1);
+	std::memcpy(W->data.get(), src, n * sizeof(float));
+	W->data[n] = W->data[0];
+	return W;
+}
+
+// sine is so common, that it's shared between ALL plugins
+static WavetableShared sineTable() {
+	static WavetableShared T = [] () {
+		const size_t n = 4096;
+		auto tmp = std::make_unique<float[]>(n);
+		for (size_t i = 0; i < n; i++)
+			tmp[i] = (float)std::sin(2.0 * M_PI * (double)i / (double)n);
+		return makeWavetable(tmp.get(), n);
+	}();
+	return T;
+}
+
+enum OscShape {
+	OSC_SINE = 0,
+	OSC_SAW,
+	OSC_SQUARE,
+	OSC_TRIANGLE,
+	OSC_TABLE
+};
+
+static const char* const shape_names[] = {
+	"sine", "saw", "square", "triangle", nullptr
+};
+
+struct Oscillator {
+	WavetableShared table; // for sine and table shapes
+	double phase; // [0, 1)
+	double rate;  // samplerate
+	int shape;
+};
+
+/*
+ * Polynomial approximation of band limited step (PolyBLEP).
+ * t is phase, dt is phase increment per sample.
+ */
+static inline double polyblep(double t, double dt) {
+	if (t < dt) {
+		t /= dt;
+		return t + t - t * t - 1.0;
+	} else if (t > 1.0 - dt) {
+		t = (t - 1.0) / dt;
+		return t * t + t + t + 1.0;
+	}
+	return 0.0;
+}
+
+static inline float lookup(const Wavetable& W, double t) {
+	double pos = t * (double)W.size;
+	size_t i = (size_t)pos;
+	float frac = (float)(pos - (double)i);
+	if (i >= W.size) i = W.size - 1; // rounding at t ~ 1.0
+	return W.data[i] + (W.data[i+1] - W.data[i]) * frac;
+}
+
+static inline float oscSample(const Oscillator& O, double t, double dt) {
+	switch (O.shape) {
+	case OSC_SAW:
+		return (float)(2.0 * t - 1.0 - polyblep(t, dt));
+	case OSC_SQUARE: {
+		double t2 = t + 0.5;
+		if (t2 >= 1.0) t2 -= 1.0;
+		return (float)((t < 0.5 ? 1.0 : -1.0) + polyblep(t, dt) - polyblep(t2, dt));
+	}
+	case OSC_TRIANGLE: // harmonics decay fast enough, so no BLEP here
+		return (float)(1.0 - 4.0 * std::fabs(t - 0.5));
+	default: // sine and table
+		return lookup(*O.table, t);
+	}
+}
+
+static inline double wrap(double t) {
+	return t - std::floor(t);
+}
+
+static void oscdtor(void* p) {
+	reinterpret_cast<Oscillator*>(p)->~Oscillator();
+}
+
+static Oscillator* checkOsc(lua_State* L) {
+	return reinterpret_cast<Oscillator*>(luaL_checkudata(L, 1, OSCNAME));
+}
+
+/*
+ * Sets shape from argument idx : shape name or wavetable (buffer or function
+ * returning it). Wavetables are cached per plugin type, if name is given.
+ */
+static void setShape(lua_State* L, Oscillator* O, int idx, const char* name) {
+	if (lua_isnoneornil(L, idx)) {
+		O->shape = OSC_SINE;
+		O->table = sineTable();
+		return;
+	} else if (lua_type(L, idx) == LUA_TSTRING) {
+		O->shape = luaL_checkoption(L, idx, nullptr, shape_names);
+		O->table = O->shape == OSC_SINE ? sineTable() : nullptr;
+		return;
+	}
+	std::string key;
+	if (name) key = strformat("wave:%s", name);
+	O->table = SharedResource<Wavetable>(GetProperties(L), key, [L, idx] () {
+		lua_pushvalue(L, idx);
+		if (lua_isfunction(L, -1)) lua_call(L, 0, 1);
+		LadspaBuffer* B = CheckBuffer(L, -1);
+		if (!B->buffer || !B->size) luaL_error(L, "wavetable is empty");
+		auto W = makeWavetable(B->buffer, B->size);
+		lua_pop(L, 1);
+		return W;
+	});
+	O->shape = OSC_TABLE;
+}
+
+// ladspa.newOscillator([shape or wavetable], [name])
+static int losc_new(lua_State* L) {
+	lua_settop(L, 2);
+	const char* name = luaL_optstring(L, 2, nullptr);
+	void* ud = lua_newuserdatadtor(L, sizeof(Oscillator), oscdtor);
+	Oscillator* O = new (ud) Oscillator{nullptr, 0.0, GetSampleRate(L),
+		OSC_SINE};
+	setShape(L, O, 1, name);
+	luaL_getmetatable(L, OSCNAME);
+	lua_setmetatable(L, -2);
+	return 1;
+}
+
+/*
+ * osc:render(output, size, freq, [fm], [depth])
+ * freq is in Hz. If fm buffer is given, frequency of each sample is
+ * freq + fm[i] * depth (depth is 1 by default).
+ */
+static int losc_render(lua_State* L) {
+	Oscillator* O = checkOsc(L);
+	LadspaBuffer* out = CheckOutBuffer(L, 2);
+	size_t sz = luaL_checkinteger(L, 3);
+	double freq = luaL_checknumber(L, 4);
+	LadspaBuffer* fm = lua_isnoneornil(L, 5) ? nullptr : CheckBuffer(L, 5);
+	double depth = luaL_optnumber(L, 6, 1.0);
+	if (!out->buffer || sz > out->size || (fm && (!fm->buffer || sz > fm->size)))
+		luaL_error(L, "size is out of buffer bounds");
+
+	sample_type* dst = out->buffer;
+	const double k = 1.0 / O->rate;
+	double t = O->phase;
+	if (!fm) {
+		const double dt = freq * k;
+		const double adt = std::fabs(dt);
+		for (size_t i = 0; i < sz; i++) {
+			dst[i] = oscSample(*O, t, adt);
+			t = wrap(t + dt);
+		}
+	} else {
+		const sample_type* mod = fm->buffer;
+		for (size_t i = 0; i < sz; i++) {
+			const double dt = (freq + (double)mod[i] * depth) * k;
+			dst[i] = oscSample(*O, t, std::fabs(dt));
+			t = wrap(t + dt);
+		}
+	}
+	O->phase = t;
+	return 0;
+}
+
+// osc:setShape(shape or wavetable, [name])
+static int losc_setShape(lua_State* L) {
+	Oscillator* O = checkOsc(L);
+	setShape(L, O, 2, luaL_optstring(L, 3, nullptr));
+	return 0;
+}
+
+static int losc_setPhase(lua_State* L) {
+	Oscillator* O = checkOsc(L);
+	O->phase = wrap(luaL_checknumber(L, 2));
+	return 0;
+}
+
+static int losc_getPhase(lua_State* L) {
+	lua_pushnumber(L, checkOsc(L)->phase);
+	return 1;
+}
+
+static int losc_reset(lua_State* L) {
+	checkOsc(L)->phase = 0.0;
+	return 0;
+}
+
+static const luaL_Reg osc_methods[] = {
+	{"render", losc_render},
+	{"setShape", losc_setShape},
+	{"setPhase", losc_setPhase},
+	{"getPhase", losc_getPhase},
+	{"reset", losc_reset},
+	{nullptr, nullptr}
+};
+
+static const luaL_Reg osc_funcs[] = {
+	{"newOscillator", losc_new},
+	{nullptr, nullptr}
+};
+
+void OpenLuaOscillator(lua_State* L) {
+	NewClass(L, OSCNAME, osc_methods);
+	luaL_register(L, "ladspa", osc_funcs);
+	lua_pop(L, 1);
+}
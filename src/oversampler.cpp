@@ -0,0 +1,205 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Polyphase oversampling of the whole plugin run()
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define OVERSAMPLER_SSE 1
+#else
+#define OVERSAMPLER_SSE 0
+#endif
+
+// taps per polyphase branch (multiple of 4 for SIMD)
+constexpr size_t taps_per_phase = 16;
+
+/*
+ * Dot product of two float arrays, n is multiple of 4.
+ * This is where oversampling spends all its time.
+ */
+static inline float dot(const float* a, const float* b, size_t n) {
+#if OVERSAMPLER_SSE
+	__m128 acc0 = _mm_setzero_ps();
+	__m128 acc1 = _mm_setzero_ps();
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4),
+			_mm_loadu_ps(b + i + 4)));
+	}
+	for (; i < n; i += 4)
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+	acc0 = _mm_add_ps(acc0, acc1);
+	acc0 = _mm_add_ps(acc0, _mm_movehl_ps(acc0, acc0));
+	acc0 = _mm_add_ss(acc0, _mm_shuffle_ps(acc0, acc0, 1));
+	return _mm_cvtss_f32(acc0);
+#else
+	float s = 0.0f;
+	for (size_t i = 0; i < n; i++) s += a[i] * b[i];
+	return s;
+#endif
+}
+
+// zeroth order modified bessel function (for kaiser window)
+static double bessel0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+/*
+ * Windowed sinc lowpass prototype at the high samplerate.
+ * Cutoff is a bit below host nyquist, kaiser window gives ~80 dB stopband.
+ */
+static std::vector<float> designLowpass(size_t factor, size_t len, double gain) {
+	std::vector<float> h(len);
+	const double fc = 0.45 / (double)factor; // cycles per sample
+	const double beta = 7.857;
+	const double mid = (double)(len - 1) * 0.5;
+	const double norm = bessel0(beta);
+	double sum = 0.0;
+	for (size_t i = 0; i < len; i++) {
+		double t = (double)i - mid;
+		double sinc = t == 0.0 ? 2.0 * fc : std::sin(2.0 * M_PI * fc * t) / (M_PI * t);
+		double r = t / mid;
+		double w = bessel0(beta * std::sqrt(std::max(0.0, 1.0 - r * r))) / norm;
+		h[i] = (float)(sinc * w);
+		sum += h[i];
+	}
+	for (auto& v : h) v = (float)(v * gain / sum);
+	return h;
+}
+
+/*
+ * History line, that always gives contiguous window of last n samples
+ * (every sample is written twice).
+ */
+struct History {
+	std::vector<float> data;
+	size_t n = 0, pos = 0;
+
+	void init(size_t size) {
+		n = size; pos = 0;
+		data.assign(n * 2, 0.0f);
+	}
+	void push(float v) {
+		data[pos] = v;
+		data[pos + n] = v;
+		if (++pos == n) pos = 0;
+	}
+	// oldest sample first
+	const float* window() const {
+		return data.data() + pos;
+	}
+	void clear() {
+		std::fill(data.begin(), data.end(), 0.0f);
+		pos = 0;
+	}
+};
+
+struct Oversampler::Channel {
+	History hist;
+	std::vector<float> buffer; // internal buffer at high samplerate
+	bool input;
+};
+
+Oversampler::Oversampler(int f, size_t count, const LADSPA_PortDescriptor* desc)
+		: mFactor(f) {
+	const size_t len = mFactor * taps_per_phase;
+	// interpolator loses factor in gain because of zero stuffing
+	std::vector<float> up = designLowpass(mFactor, len, (double)mFactor);
+	std::vector<float> down = designLowpass(mFactor, len, 1.0);
+
+	// reversed polyphase branches for interpolation :
+	// y[n*L + p] = sum(h[k*L + p] * x[n - k])
+	mUp.resize(len);
+	for (size_t p = 0; p < mFactor; p++)
+		for (size_t j = 0; j < taps_per_phase; j++)
+			mUp[p * taps_per_phase + j] = up[(taps_per_phase - 1 - j) * mFactor + p];
+	// reversed prototype for decimation
+	mDown.resize(len);
+	for (size_t i = 0; i < len; i++) mDown[i] = down[len - 1 - i];
+
+	mChannels.resize(count);
+	for (size_t i = 0; i < count; i++) {
+		if (!IS_AUDIO(desc[i])) continue;
+		auto C = std::make_unique<Channel>();
+		C->input = IS_INPUT(desc[i]);
+		C->hist.init(C->input ? taps_per_phase : len);
+		mChannels[i] = std::move(C);
+	}
+}
+
+Oversampler::~Oversampler() = default;
+
+size_t Oversampler::latency() const {
+	// both filters are linear phase, (len-1)/2 high rate samples each,
+	// and decimator takes last sample of each group (factor-1 less).
+	// (len - 1 - (factor - 1)) / factor is always an integer
+	return taps_per_phase - 1;
+}
+
+void Oversampler::reset() {
+	for (auto& C : mChannels) if (C) C->hist.clear();
+}
+
+size_t Oversampler::prepare(size_t n) {
+	const size_t hn = n * mFactor;
+	for (auto& C : mChannels) {
+		// allocates only when host block grows
+		if (C && C->buffer.size() < hn) C->buffer.resize(hn);
+	}
+	return hn;
+}
+
+sample_type* Oversampler::buffer(size_t port) {
+	return mChannels[port]->buffer.data();
+}
+
+sample_type* Oversampler::upsample(size_t port, const sample_type* in, size_t n) {
+	Channel& C = *mChannels[port];
+	sample_type* out = C.buffer.data();
+	if (!in) { // not connected
+		std::memset(out, 0, n * mFactor * sizeof(sample_type));
+		return out;
+	}
+	for (size_t i = 0; i < n; i++) {
+		C.hist.push(in[i]);
+		const float* w = C.hist.window();
+		for (size_t p = 0; p < mFactor; p++)
+			*out++ = dot(w, mUp.data() + p * taps_per_phase, taps_per_phase);
+	}
+	return C.buffer.data();
+}
+
+void Oversampler::downsample(size_t port, sample_type* out, size_t n) {
+	Channel& C = *mChannels[port];
+	const sample_type* in = C.buffer.data();
+	const size_t len = mDown.size();
+	for (size_t i = 0; i < n; i++) {
+		for (size_t p = 0; p < mFactor; p++) C.hist.push(*in++);
+		if (out) out[i] = dot(C.hist.window(), mDown.data(), len);
+	}
+}
@@ -0,0 +1,112 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Pool of warm instances, reused after cleanup()
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include <atomic>
+
+/*
+ * Hosts often cleanup() and instantiate() the same plugin again (toggling
+ * tracks, reloading projects), and every new instance creates lua state
+ * and runs main chunk. Instances of plugins with reset() are reset and
+ * kept here instead, up to info.pool per plugin type and
+ * pool_memory_limit for all of them.
+ * Pooled instance doesn't reference it's properties (they own the pool),
+ * and it's not registered and has no telemetry slot.
+ */
+class InstancePool {
+	public:
+	struct Entry {
+		std::unique_ptr<PluginHandle> H;
+		size_t memory;
+	};
+	std::mutex lock;
+	std::vector<Entry> list;
+};
+
+static std::atomic<size_t> pooledMemory(0);
+
+static size_t instanceMemory(PluginHandle* H) {
+	size_t n = H->L.allocdata.allocated;
+	for (size_t i = 0; i < GraphNodeCount(H); i++)
+		n += instanceMemory(GetGraphNode(H, i));
+	return n;
+}
+
+// graph nodes are registered instances with telemetry too
+static void release(PluginHandle* H) {
+	UnregisterInstance(H);
+	H->telemetry.reset();
+	for (size_t i = 0; i < GraphNodeCount(H); i++) release(GetGraphNode(H, i));
+}
+
+static void restore(PluginHandle* H) {
+	H->messages = NewMessageQueue(); // nothing from the previous owner
+	H->telemetry = NewTelemetry(H);
+	RegisterInstance(H);
+	for (size_t i = 0; i < GraphNodeCount(H); i++) restore(GetGraphNode(H, i));
+}
+
+void InstancePoolDeleter::operator()(InstancePool* P) const {
+	for (auto& e : P->list) pooledMemory -= e.memory;
+	delete P;
+}
+
+InstancePoolPtr NewInstancePool() {
+	return InstancePoolPtr(new InstancePool);
+}
+
+bool PoolInstance(PluginHandle* H) {
+	PlugPropShared props = std::move(H->P);
+	InstancePool* pool = props->pool.get();
+	const size_t memory = instanceMemory(H);
+	if (pool && props->poolSize > 0) {
+		std::lock_guard<std::mutex> guard(pool->lock);
+		// limit is common for all pools (and their locks)
+		if (pool->list.size() < (size_t)props->poolSize) {
+			if (pooledMemory.fetch_add(memory) + memory <= pool_memory_limit) {
+				release(H);
+				pool->list.push_back({std::unique_ptr<PluginHandle>(H), memory});
+				return true;
+			}
+			pooledMemory -= memory; // over the limit, rollback
+		}
+	}
+	H->P = std::move(props);
+	return false;
+}
+
+PluginHandle* TakeInstance(PlugPropShared props, unsigned long rate) {
+	InstancePool* pool = props->pool.get();
+	if (!pool) return nullptr;
+	std::unique_ptr<PluginHandle> H;
+	{
+		std::lock_guard<std::mutex> guard(pool->lock);
+		auto& list = pool->list;
+		for (size_t i = list.size(); i-- > 0;) if (list[i].H->samplerate == rate) {
+			H = std::move(list[i].H);
+			pooledMemory -= list[i].memory;
+			list.erase(list.begin() + i);
+			break;
+		}
+	}
+	if (!H) return nullptr;
+	H->P = std::move(props);
+	restore(H.get());
+	return H.release();
+}
@@ -0,0 +1,53 @@
+#pragma once
+// Lock free single producer/single consumer ring queue.
+// Slots are preallocated and reused in place, so if T keeps its
+// capacity (std::string, std::vector), steady state pushes and pops
+// do not allocate anything.
+#include <atomic>
+#include <cstddef>
+
+template <typename T, size_t N>
+class SPSCQueue {
+	static_assert(N >= 2 && (N & (N - 1)) == 0, "size must be power of two");
+	T slots[N];
+	alignas(64) std::atomic<size_t> head{0}; // written by consumer
+	alignas(64) std::atomic<size_t> tail{0}; // written by producer
+	public:
+	SPSCQueue() = default;
+	SPSCQueue(const SPSCQueue&) = delete;
+
+	// producer : slot to fill, or nullptr if queue is full
+	T* back() {
+		size_t t = tail.load(std::memory_order_relaxed);
+		if (t - head.load(std::memory_order_acquire) >= N) return nullptr;
+		return &slots[t & (N - 1)];
+	}
+	// producer : publish filled slot
+	void push() {
+		tail.store(tail.load(std::memory_order_relaxed) + 1,
+			std::memory_order_release);
+	}
+
+	// consumer : oldest slot, or nullptr if queue is empty
+	T* front() {
+		size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire)) return nullptr;
+		return &slots[h & (N - 1)];
+	}
+	// consumer : release slot back to the producer
+	void pop() {
+		head.store(head.load(std::memory_order_relaxed) + 1,
+			std::memory_order_release);
+	}
+
+	// NOT thread safe, for slots initialization only
+	template <typename F>
+	void forEachSlot(F f) {
+		for (auto& s : slots) f(s);
+	}
+
+	bool empty() const {
+		return head.load(std::memory_order_acquire) ==
+			tail.load(std::memory_order_acquire);
+	}
+};
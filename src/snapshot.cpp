@@ -0,0 +1,257 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Snapshot of plugin data after main chunk, to reuse instances
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include <cstring>
+
+/*
+ * Pooled instance must look like it was just loaded. Plugins with reset()
+ * do it themselves, for others everything reachable from the globals
+ * (and environments of chain stages) is copied right after main chunk :
+ * contents of tables, upvalues of lua functions and internal buffers.
+ * Restoring writes it back into the same objects, so references between
+ * them (and closures) are still valid. Native objects are reset with
+ * their reset() method, readonly tables are not copied at all.
+ * Parameters of native objects are NOT restored : plugin must set them in
+ * activate() (or define reset()), if run() changes them.
+ *
+ * Taking snapshot is opt-in (info.snapshot), it costs time and memory of
+ * every instance. Memory of the snapshot is added to the memory limit of
+ * the instance, so run() has as much memory as without it.
+ *
+ * Snapshot lives in the registry, as table object -> copy :
+ * table -> table with the same fields (and metatable at metakey)
+ * lua function -> array of upvalues
+ * internal buffer -> buffer with the same data
+ * anything else (readonly table, C function, native object) -> true
+ * It's in the same lua state, objects can't be moved to another one.
+ */
+
+static const char metakey = 0; // key of the metatable in table copies
+
+static void enqueue(lua_State* L, int Q, int& n, int idx) {
+	switch (lua_type(L, idx)) {
+		case LUA_TTABLE: case LUA_TFUNCTION: case LUA_TUSERDATA: case LUA_TTHREAD:
+			lua_pushvalue(L, idx);
+			lua_rawseti(L, Q, ++n);
+		default: break;
+	}
+}
+
+static bool isBuffer(lua_State* L, int idx, int BMT) {
+	if (!lua_getmetatable(L, idx)) return false;
+	bool res = lua_rawequal(L, -1, BMT);
+	lua_pop(L, 1);
+	return res;
+}
+
+// snapshot(roots...) -> snapshot table
+static int lsnap_take(lua_State* L) {
+	const int roots = lua_gettop(L);
+	lua_newtable(L);
+	const int S = lua_gettop(L);
+	lua_newtable(L); // objects to visit
+	const int Q = lua_gettop(L);
+	luaL_getmetatable(L, "_bufferMT");
+	const int BMT = lua_gettop(L);
+	int n = 0;
+	for (int i = 1; i <= roots; i++) enqueue(L, Q, n, i);
+
+	for (int head = 1; head <= n; head++) {
+		lua_rawgeti(L, Q, head);
+		const int v = lua_gettop(L);
+		lua_pushvalue(L, v);
+		if (lua_rawget(L, S) != LUA_TNIL) { // already here
+			lua_pop(L, 2);
+			continue;
+		}
+		lua_pop(L, 1);
+		switch (lua_type(L, v)) {
+		case LUA_TTABLE: {
+			const bool copy = !lua_getreadonly(L, v);
+			if (copy) lua_newtable(L);
+			else lua_pushboolean(L, 1);
+			const int C = lua_gettop(L);
+			if (lua_getmetatable(L, v)) {
+				enqueue(L, Q, n, -1);
+				if (copy) {
+					lua_pushlightuserdata(L, (void*)&metakey);
+					lua_insert(L, -2);
+					lua_rawset(L, C);
+				} else lua_pop(L, 1);
+			}
+			lua_pushnil(L);
+			while (lua_next(L, v)) {
+				enqueue(L, Q, n, -2);
+				enqueue(L, Q, n, -1);
+				if (copy) {
+					lua_pushvalue(L, -2);
+					lua_insert(L, -2);
+					lua_rawset(L, C);
+				} else lua_pop(L, 1);
+			}
+			break;
+		}
+		case LUA_TFUNCTION:
+			if (lua_iscfunction(L, v)) {
+				lua_pushboolean(L, 1);
+				break;
+			}
+			lua_newtable(L);
+			for (int i = 1; lua_getupvalue(L, v, i); i++) {
+				enqueue(L, Q, n, -1);
+				lua_rawseti(L, -2, i);
+			}
+			lua_getfenv(L, v);
+			enqueue(L, Q, n, -1);
+			lua_pop(L, 1);
+			break;
+		case LUA_TUSERDATA:
+			if (isBuffer(L, v, BMT) &&
+					!reinterpret_cast<LadspaBuffer*>(lua_touserdata(L, v))->external) {
+				LadspaBuffer* B = reinterpret_cast<LadspaBuffer*>(lua_touserdata(L, v));
+				LadspaBuffer* C = AllocBuffer(L, B->size);
+				if (B->size) std::memcpy(C->buffer, B->buffer, B->size * sizeof(sample_type));
+			} else lua_pushboolean(L, 1);
+			break;
+		default: // thread
+			luaL_error(L, "coroutines can't be restored");
+		}
+		lua_pushvalue(L, v);
+		lua_insert(L, -2);
+		lua_rawset(L, S);
+		lua_pop(L, 1); // v
+	}
+	lua_pushvalue(L, S);
+	return 1;
+}
+
+// calls obj:reset() of native object, if it has one
+static void resetNative(lua_State* L, int idx) {
+	if (!luaL_getmetafield(L, idx, "__index")) return;
+	if (lua_istable(L, -1)) {
+		lua_getfield(L, -1, "reset");
+		if (lua_isfunction(L, -1)) {
+			lua_pushvalue(L, idx);
+			lua_call(L, 1, 0);
+		} else lua_pop(L, 1);
+	}
+	lua_pop(L, 1);
+}
+
+// restore(snapshot)
+static int lsnap_restore(lua_State* L) {
+	const int S = 1;
+	luaL_getmetatable(L, "_bufferMT");
+	const int BMT = lua_gettop(L);
+	lua_pushnil(L);
+	while (lua_next(L, S)) {
+		const int k = lua_gettop(L) - 1, c = k + 1;
+		switch (lua_type(L, k)) {
+		case LUA_TTABLE:
+			if (!lua_istable(L, c)) break;
+			lua_pushnil(L); // clear
+			while (lua_next(L, k)) {
+				lua_pop(L, 1);
+				lua_pushvalue(L, -1);
+				lua_pushnil(L);
+				lua_rawset(L, k);
+			}
+			lua_pushnil(L);
+			while (lua_next(L, c)) {
+				if (lua_tolightuserdata(L, -2) == &metakey) {
+					lua_pop(L, 1);
+					continue;
+				}
+				lua_pushvalue(L, -2);
+				lua_insert(L, -2);
+				lua_rawset(L, k);
+			}
+			lua_pushlightuserdata(L, (void*)&metakey);
+			lua_rawget(L, c);
+			lua_setmetatable(L, k);
+			break;
+		case LUA_TFUNCTION:
+			if (!lua_istable(L, c)) break;
+			for (int i = 1; ; i++) {
+				lua_rawgeti(L, c, i);
+				if (!lua_setupvalue(L, k, i)) {
+					lua_pop(L, 1);
+					break;
+				}
+			}
+			break;
+		case LUA_TUSERDATA:
+			if (lua_isuserdata(L, c)) { // internal buffer
+				LadspaBuffer* B = reinterpret_cast<LadspaBuffer*>(lua_touserdata(L, k));
+				LadspaBuffer* C = reinterpret_cast<LadspaBuffer*>(lua_touserdata(L, c));
+				if (B->size != C->size) ResizeBuffer(L, B, C->size);
+				if (C->size) std::memcpy(B->buffer, C->buffer, C->size * sizeof(sample_type));
+			} else if (!isBuffer(L, k, BMT)) resetNative(L, k);
+			break;
+		default: break;
+		}
+		lua_pop(L, 1); // value
+	}
+	return 0;
+}
+
+// globals and environments of chain stages
+static int pushRoots(PluginHandle* H) {
+	LuaState& L = H->L;
+	lua_pushvalue(L, LUA_GLOBALSINDEX);
+	size_t stages = H->chain ? H->P->stages.size() : 0;
+	for (size_t s = 0; s < stages; s++) PushStage(H, s);
+	return 1 + stages;
+}
+
+bool TakeSnapshot(PluginHandle* H) {
+	LuaState& L = H->L;
+	auto& A = L.allocdata;
+	lua_gc(L, LUA_GCCOLLECT, 0);
+	const size_t before = A.allocated;
+	lua_pushcfunction(L, lsnap_take, "snapshot");
+	int n = pushRoots(H);
+	if (lua_pcall(L, n, 1, 0) != LUA_OK) {
+		logInfo("Plugin %s can't be reused : %s", H->P->label, lua_tostring(L, -1));
+		lua_pop(L, 1);
+		return false;
+	}
+	lua_setfield(L, LUA_REGISTRYINDEX, "snapshot");
+	lua_gc(L, LUA_GCCOLLECT, 0);
+	if (A.allocated > before) A.maxlimit += A.allocated - before;
+	return true;
+}
+
+bool RestoreSnapshot(PluginHandle* H) {
+	LuaState& L = H->L;
+	lua_getfield(L, LUA_REGISTRYINDEX, "snapshot");
+	if (!lua_istable(L, -1)) {
+		lua_pop(L, 1);
+		return false;
+	}
+	lua_pushcfunction(L, lsnap_restore, "restore");
+	lua_insert(L, -2);
+	if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+		logError("Can't restore plugin %s : %s", H->P->label, lua_tostring(L, -1));
+		lua_pop(L, 1);
+		return false;
+	}
+	return true;
+}
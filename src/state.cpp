@@ -0,0 +1,495 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Saving and loading state of plugin instances (presets)
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "lualadspa_c.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+/*
+ * saveState() hook of the plugin returns any value, and host gives it
+ * back to loadState(state) later (in another session too). State is
+ * saved by the host thread : run() skips blocks while it holds the lock.
+ *
+ * Format : "LLS" + version byte, varint length + label, then instance :
+ * varint count + value of each stage (1 for usual plugin), or
+ * varint count + instance of each node for graphs.
+ * Value is type byte + data. Integers are zigzag varints, buffers are
+ * raw float arrays, tables are array part (varint count + values) and
+ * then key/value pairs up to nil key. Table met again is a reference
+ * to it's number, so shared tables and cycles are kept.
+ */
+constexpr char state_magic[] = "LLS";
+constexpr char state_version = 1;
+constexpr int state_max_depth = 128;
+
+enum StateTag : char {
+	ST_NIL = 0, ST_FALSE, ST_TRUE, ST_INTEGER, ST_NUMBER, ST_STRING,
+	ST_VECTOR, ST_BUFFER, ST_TABLE, ST_REF
+};
+
+static void putVarint(std::string& out, uint64_t v) {
+	while (v >= 0x80) {
+		out += char(v | 0x80);
+		v >>= 7;
+	}
+	out += char(v);
+}
+
+static bool getVarint(const char*& p, const char* end, uint64_t& v) {
+	v = 0;
+	for (int shift = 0; shift < 64 && p < end; shift += 7) {
+		uint8_t b = *p++;
+		v |= (uint64_t)(b & 0x7F) << shift;
+		if (!(b & 0x80)) return true;
+	}
+	return false;
+}
+
+static bool isBuffer(lua_State* L, int idx) {
+	if (!lua_getmetatable(L, idx)) return false;
+	luaL_getmetatable(L, "_bufferMT");
+	bool res = lua_rawequal(L, -1, -2);
+	lua_pop(L, 2);
+	return res;
+}
+
+class StateWriter {
+	public:
+	lua_State* L;
+	std::string& out;
+	int seen; // table -> number
+	uint64_t tables = 0;
+
+	StateWriter(lua_State* L, std::string& out) : L(L), out(out) {
+		lua_newtable(L);
+		seen = lua_gettop(L);
+	}
+
+	void value(int idx, int depth) {
+		if (idx < 0) idx = lua_gettop(L) + idx + 1;
+		switch (lua_type(L, idx)) {
+		case LUA_TNIL: out += ST_NIL; break;
+		case LUA_TBOOLEAN: out += lua_toboolean(L, idx) ? ST_TRUE : ST_FALSE; break;
+		case LUA_TNUMBER: {
+			double d = lua_tonumber(L, idx);
+			if (d == std::floor(d) && std::fabs(d) < 9007199254740992.0 &&
+					!(d == 0 && std::signbit(d))) {
+				int64_t i = (int64_t)d;
+				out += ST_INTEGER;
+				putVarint(out, ((uint64_t)i << 1) ^ (uint64_t)(i >> 63));
+			} else {
+				out += ST_NUMBER;
+				out.append(reinterpret_cast<const char*>(&d), sizeof(d));
+			}
+			break;
+		}
+		case LUA_TSTRING: {
+			size_t len;
+			const char* s = lua_tolstring(L, idx, &len);
+			out += ST_STRING;
+			putVarint(out, len);
+			out.append(s, len);
+			break;
+		}
+		case LUA_TVECTOR:
+			out += ST_VECTOR;
+			out.append(reinterpret_cast<const char*>(lua_tovector(L, idx)),
+				sizeof(float) * 4);
+			break;
+		case LUA_TUSERDATA: {
+			if (!isBuffer(L, idx)) luaL_error(L, "native objects can't be saved");
+			LadspaBuffer* B = CheckBuffer(L, idx);
+			out += ST_BUFFER;
+			putVarint(out, B->size);
+			if (B->size) out.append(reinterpret_cast<const char*>(B->buffer),
+				B->size * sizeof(sample_type));
+			break;
+		}
+		case LUA_TTABLE:
+			table(idx, depth);
+			break;
+		default:
+			luaL_error(L, "%s can't be saved", luaL_typename(L, idx));
+		}
+	}
+
+	void table(int idx, int depth) {
+		if (depth > state_max_depth) luaL_error(L, "state is too deep");
+		luaL_checkstack(L, 4, "state is too deep");
+		lua_pushvalue(L, idx);
+		if (lua_rawget(L, seen) == LUA_TNUMBER) {
+			out += ST_REF;
+			putVarint(out, (uint64_t)lua_tonumber(L, -1));
+			lua_pop(L, 1);
+			return;
+		}
+		lua_pop(L, 1);
+		lua_pushvalue(L, idx);
+		lua_pushnumber(L, (double)tables++);
+		lua_rawset(L, seen);
+
+		out += ST_TABLE;
+		const int n = lua_objlen(L, idx);
+		putVarint(out, n);
+		for (int i = 1; i <= n; i++) {
+			lua_rawgeti(L, idx, i);
+			value(-1, depth + 1);
+			lua_pop(L, 1);
+		}
+		lua_pushnil(L);
+		while (lua_next(L, idx)) {
+			if (lua_type(L, -2) == LUA_TNUMBER) { // array part is written already
+				double k = lua_tonumber(L, -2);
+				if (k >= 1 && k <= n && k == std::floor(k)) {
+					lua_pop(L, 1);
+					continue;
+				}
+			}
+			value(-2, depth + 1);
+			value(-1, depth + 1);
+			lua_pop(L, 1);
+		}
+		out += ST_NIL;
+	}
+};
+
+class StateReader {
+	public:
+	lua_State* L;
+	const char* p;
+	const char* end;
+	int tables; // number -> table
+	int count = 0;
+
+	StateReader(lua_State* L, const char* p, const char* end) :
+			L(L), p(p), end(end) {
+		lua_newtable(L);
+		tables = lua_gettop(L);
+	}
+
+	[[noreturn]] void corrupted() {
+		luaL_error(L, "corrupted state");
+		abort(); // not reached
+	}
+
+	void need(size_t n) {
+		if ((size_t)(end - p) < n) corrupted();
+	}
+
+	uint64_t varint() {
+		uint64_t v;
+		if (!getVarint(p, end, v)) corrupted();
+		return v;
+	}
+
+	// pushes next value
+	void value(int depth) {
+		if (depth > state_max_depth) luaL_error(L, "state is too deep");
+		luaL_checkstack(L, 4, "state is too deep");
+		need(1);
+		switch (*p++) {
+		case ST_NIL: lua_pushnil(L); break;
+		case ST_FALSE: lua_pushboolean(L, 0); break;
+		case ST_TRUE: lua_pushboolean(L, 1); break;
+		case ST_INTEGER: {
+			uint64_t z = varint();
+			lua_pushnumber(L, (double)(int64_t)((z >> 1) ^ (~(z & 1) + 1)));
+			break;
+		}
+		case ST_NUMBER: {
+			double d;
+			need(sizeof(d));
+			std::memcpy(&d, p, sizeof(d));
+			p += sizeof(d);
+			lua_pushnumber(L, d);
+			break;
+		}
+		case ST_STRING: {
+			uint64_t len = varint();
+			need(len);
+			lua_pushlstring(L, p, len);
+			p += len;
+			break;
+		}
+		case ST_VECTOR: {
+			float v[4];
+			need(sizeof(v));
+			std::memcpy(v, p, sizeof(v));
+			p += sizeof(v);
+			lua_pushvector(L, v[0], v[1], v[2], v[3]);
+			break;
+		}
+		case ST_BUFFER: {
+			uint64_t len = varint();
+			if (len > (size_t)(end - p) / sizeof(sample_type)) corrupted();
+			LadspaBuffer* B = AllocBuffer(L, len);
+			if (len) std::memcpy(B->buffer, p, len * sizeof(sample_type));
+			p += len * sizeof(sample_type);
+			break;
+		}
+		case ST_TABLE: {
+			uint64_t n = varint();
+			if (n > (size_t)(end - p)) corrupted(); // at least byte per value
+			lua_createtable(L, n, 0);
+			const int t = lua_gettop(L);
+			lua_pushvalue(L, t);
+			lua_rawseti(L, tables, ++count);
+			for (uint64_t i = 1; i <= n; i++) {
+				value(depth + 1);
+				lua_rawseti(L, t, i);
+			}
+			for (;;) {
+				value(depth + 1);
+				if (lua_isnil(L, -1)) break;
+				value(depth + 1);
+				if (lua_type(L, -2) == LUA_TNUMBER && std::isnan(lua_tonumber(L, -2)))
+					corrupted();
+				lua_rawset(L, t);
+			}
+			lua_pop(L, 1);
+			break;
+		}
+		case ST_REF: {
+			uint64_t i = varint();
+			if (i >= (uint64_t)count) corrupted();
+			lua_rawgeti(L, tables, i + 1);
+			break;
+		}
+		default:
+			corrupted();
+		}
+	}
+};
+
+// pushes hook of the stage (nil if there is no such function)
+static void pushStageHook(PluginHandle* H, size_t stage, const char* field) {
+	lua_State* L = H->L;
+	if (H->chain) {
+		PushStage(H, stage);
+		lua_getfield(L, -1, field);
+		lua_remove(L, -2);
+	} else lua_getfield(L, LUA_GLOBALSINDEX, field);
+	if (!lua_isfunction(L, -1)) {
+		lua_pop(L, 1);
+		lua_pushnil(L);
+	}
+}
+
+static size_t stageCount(PluginHandle* H) {
+	return H->chain ? H->P->stages.size() : 1;
+}
+
+// save(out) : writes count and saveState() results of the stages
+static int lstate_save(lua_State* L) {
+	PluginHandle* H = GetHandle(L);
+	std::string& out = *reinterpret_cast<std::string*>(lua_touserdata(L, 1));
+	StateWriter W(L, out);
+	putVarint(out, stageCount(H));
+	for (size_t s = 0; s < stageCount(H); s++) {
+		pushStageHook(H, s, "saveState");
+		if (!lua_isnil(L, -1)) lua_call(L, 0, 1);
+		W.value(-1, 0);
+		lua_pop(L, 1);
+	}
+	return 0;
+}
+
+struct StateInput {
+	const char* p;
+	const char* end;
+};
+
+/*
+ * Loading is done in two steps : all values (of all stages, and of all
+ * graph nodes) are decoded into registry "loadingState" first, so broken
+ * state changes nothing. Then they are given to loadState() hooks.
+ */
+
+// decode(in) : reads values of all stages
+static int lstate_decode(lua_State* L) {
+	PluginHandle* H = GetHandle(L);
+	StateInput& in = *reinterpret_cast<StateInput*>(lua_touserdata(L, 1));
+	StateReader R(L, in.p, in.end);
+	if (R.varint() != stageCount(H)) luaL_error(L, "state of other plugin");
+	lua_createtable(L, stageCount(H), 0);
+	const int values = lua_gettop(L);
+	for (size_t s = 0; s < stageCount(H); s++) {
+		R.value(0);
+		lua_rawseti(L, values, s + 1);
+	}
+	in.p = R.p;
+	lua_setfield(L, LUA_REGISTRYINDEX, "loadingState");
+	return 0;
+}
+
+// apply() : gives decoded values to the stages
+static int lstate_apply(lua_State* L) {
+	PluginHandle* H = GetHandle(L);
+	lua_getfield(L, LUA_REGISTRYINDEX, "loadingState");
+	const int values = lua_gettop(L);
+	lua_pushnil(L);
+	lua_setfield(L, LUA_REGISTRYINDEX, "loadingState");
+	for (size_t s = 0; s < stageCount(H); s++) {
+		pushStageHook(H, s, "loadState");
+		if (lua_isnil(L, -1)) {
+			lua_pop(L, 1);
+			continue;
+		}
+		lua_rawgeti(L, values, s + 1);
+		lua_call(L, 1, 0);
+	}
+	return 0;
+}
+
+static bool saveInstance(PluginHandle* H, std::string& out) {
+	std::lock_guard<std::mutex> guard(H->stateLock);
+	if (H->shutdown) return false;
+	if (H->graph) {
+		putVarint(out, GraphNodeCount(H));
+		for (size_t i = 0; i < GraphNodeCount(H); i++)
+			if (!saveInstance(GetGraphNode(H, i), out)) return false;
+		return true;
+	}
+	lua_State* L = H->L;
+	lua_pushcfunction(L, lstate_save, "saveState");
+	lua_pushlightuserdata(L, &out);
+	if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+		logError("Can't save state of plugin %s : %s", H->P->label,
+			lua_tostring(L, -1));
+		lua_pop(L, 1);
+		return false;
+	}
+	return true;
+}
+
+static bool decodeInstance(PluginHandle* H, StateInput& in) {
+	std::lock_guard<std::mutex> guard(H->stateLock);
+	if (H->shutdown) return false;
+	if (H->graph) {
+		uint64_t n;
+		if (!getVarint(in.p, in.end, n) || n != GraphNodeCount(H)) {
+			logError("Can't load state of plugin %s : state of other plugin",
+				H->P->label);
+			return false;
+		}
+		for (size_t i = 0; i < n; i++)
+			if (!decodeInstance(GetGraphNode(H, i), in)) return false;
+		return true;
+	}
+	lua_State* L = H->L;
+	lua_pushcfunction(L, lstate_decode, "loadState");
+	lua_pushlightuserdata(L, &in);
+	if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+		logError("Can't load state of plugin %s : %s", H->P->label,
+			lua_tostring(L, -1));
+		lua_pop(L, 1);
+		return false;
+	}
+	return true;
+}
+
+// decoded values are dropped (if some node of the graph is broken)
+static void discardInstance(PluginHandle* H) {
+	std::lock_guard<std::mutex> guard(H->stateLock);
+	for (size_t i = 0; i < GraphNodeCount(H); i++)
+		discardInstance(GetGraphNode(H, i));
+	if (H->graph) return;
+	lua_pushnil(H->L);
+	lua_setfield(H->L, LUA_REGISTRYINDEX, "loadingState");
+}
+
+// error in loadState() of one node doesn't stop others
+static bool applyInstance(PluginHandle* H) {
+	std::lock_guard<std::mutex> guard(H->stateLock);
+	if (H->shutdown) return false;
+	if (H->graph) {
+		bool ok = true;
+		for (size_t i = 0; i < GraphNodeCount(H); i++)
+			ok = applyInstance(GetGraphNode(H, i)) && ok;
+		return ok;
+	}
+	lua_State* L = H->L;
+	lua_pushcfunction(L, lstate_apply, "loadState");
+	if (lua_pcall(L, 0, 0, 0) != LUA_OK) {
+		logError("Can't load state of plugin %s : %s", H->P->label,
+			lua_tostring(L, -1));
+		lua_pop(L, 1);
+		return false;
+	}
+	return true;
+}
+
+static bool loadInstance(PluginHandle* H, StateInput& in) {
+	if (!decodeInstance(H, in)) {
+		discardInstance(H);
+		return false;
+	}
+	return applyInstance(H);
+}
+
+/*
+ * C API
+ */
+
+extern "C" void* lualadspa_save_state(LADSPA_Handle instance, size_t* size) {
+	PluginHandle* H = reinterpret_cast<PluginHandle*>(instance);
+	if (!H || !size) return nullptr;
+	std::string out(state_magic);
+	out += state_version;
+	putVarint(out, std::strlen(H->P->label));
+	out += H->P->label;
+	if (!saveInstance(H, out)) return nullptr;
+	void* data = std::malloc(out.size());
+	if (!data) return nullptr;
+	std::memcpy(data, out.data(), out.size());
+	*size = out.size();
+	return data;
+}
+
+extern "C" void lualadspa_free_state(void* state) {
+	std::free(state);
+}
+
+extern "C" int lualadspa_load_state(LADSPA_Handle instance, const void* data,
+		size_t size) {
+	PluginHandle* H = reinterpret_cast<PluginHandle*>(instance);
+	if (!H || !data) return 0;
+	const size_t header = sizeof(state_magic) - 1;
+	const size_t label = std::strlen(H->P->label);
+	StateInput in{reinterpret_cast<const char*>(data),
+		reinterpret_cast<const char*>(data) + size};
+	uint64_t len;
+	if (size <= header || std::memcmp(in.p, state_magic, header) ||
+			in.p[header] != state_version) {
+		logError("Can't load state of plugin %s : not a lualadspa state",
+			H->P->label);
+		return 0;
+	}
+	in.p += header + 1;
+	if (!getVarint(in.p, in.end, len) || len != label ||
+			(size_t)(in.end - in.p) < label || std::memcmp(in.p, H->P->label, label)) {
+		logError("Can't load state of plugin %s : state of other plugin",
+			H->P->label);
+		return 0;
+	}
+	in.p += label;
+	return loadInstance(H, in);
+}
@@ -0,0 +1,174 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Per instance stats in shared memory, for `lualadspa top`
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "lualadspa_c.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define HAS_TELEMETRY 1
+#endif
+
+/*
+ * Audio thread only writes to it's own slot in the mapped table, so
+ * there is no IPC and no syscalls on the audio path. Slots are taken
+ * and released under the lock (instantiate()/cleanup()).
+ */
+class TelemetrySegment {
+	public:
+	lualadspa_telemetry* table = nullptr;
+	std::mutex lock;
+	uint64_t nextId = 1;
+	bool failed = false;
+#ifdef HAS_TELEMETRY
+	std::string name;
+
+	bool open() {
+		if (table) return true;
+		if (failed) return false;
+		failed = true; // don't try again
+		name = strformat(LUALADSPA_TELEMETRY_PREFIX "%i", (int)getpid());
+		shm_unlink(name.c_str()); // stale one, from process with the same pid
+		int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+		if (fd < 0) {
+			logError("Can't create telemetry segment %s!", name.c_str());
+			return false;
+		}
+		void* p = MAP_FAILED;
+		if (ftruncate(fd, sizeof(lualadspa_telemetry)) == 0)
+			p = mmap(nullptr, sizeof(lualadspa_telemetry), PROT_READ | PROT_WRITE,
+				MAP_SHARED, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED) {
+			logError("Can't map telemetry segment %s!", name.c_str());
+			shm_unlink(name.c_str());
+			return false;
+		}
+		table = reinterpret_cast<lualadspa_telemetry*>(p); // zeroed
+		table->version = LUALADSPA_TELEMETRY_VERSION;
+		table->pid = getpid();
+		table->slots = LUALADSPA_TELEMETRY_SLOTS;
+		__atomic_store_n(&table->magic, LUALADSPA_TELEMETRY_MAGIC, __ATOMIC_RELEASE);
+		failed = false;
+		return true;
+	}
+
+	~TelemetrySegment() {
+		if (!table) return;
+		munmap(table, sizeof(lualadspa_telemetry));
+		shm_unlink(name.c_str());
+	}
+#else
+	bool open() {return false;}
+#endif
+};
+
+static TelemetrySegment segment;
+
+class Telemetry {
+	public:
+	lualadspa_stats* stats;
+	// lua GC steps are measured through interrupt callback
+	std::chrono::steady_clock::time_point gcStart;
+	double gcTime = 0.0;
+	bool inGC = false;
+};
+
+void TelemetryDeleter::operator()(Telemetry* T) const {
+	std::lock_guard<std::mutex> guard(segment.lock);
+	__atomic_store_n(&T->stats->active, 0, __ATOMIC_RELEASE);
+	delete T;
+}
+
+// called before and after each GC step (see instance interrupt)
+void TelemetryGC(PluginHandle* H) {
+	Telemetry* T = H->telemetry.get();
+	if (!T) return;
+	auto now = std::chrono::steady_clock::now();
+	if (T->inGC) T->gcTime += std::chrono::duration<double>(now - T->gcStart).count();
+	else T->gcStart = now;
+	T->inGC = !T->inGC;
+}
+
+TelemetryPtr NewTelemetry(PluginHandle* H) {
+	std::lock_guard<std::mutex> guard(segment.lock);
+	if (!segment.open()) return nullptr;
+	lualadspa_stats* S = nullptr;
+	for (auto& slot : segment.table->stats) if (!slot.active) {
+		S = &slot;
+		break;
+	}
+	if (!S) {
+		logError("No free telemetry slots for plugin %s!", H->P->name);
+		return nullptr;
+	}
+
+	uint32_t seq = S->seq; // keep it growing, reader may hold the old one
+	__atomic_store_n(&S->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	std::memset(reinterpret_cast<char*>(S) + sizeof(S->seq), 0,
+		sizeof(lualadspa_stats) - sizeof(S->seq));
+	S->id = segment.nextId++;
+	std::strncpy(S->label, H->P->label, LUALADSPA_LABEL_MAX - 1);
+	S->samplerate = H->samplerate;
+	S->active = 1;
+	__atomic_store_n(&S->seq, seq + 2, __ATOMIC_RELEASE);
+
+	TelemetryPtr T(new Telemetry);
+	T->stats = S;
+	return T;
+}
+
+// half octave buckets of microseconds
+static inline int histBucket(double seconds) {
+	double us = seconds * 1e6;
+	if (us < 1.0) return 0;
+	int b = std::ilogb(us * us);
+	return b < LUALADSPA_TELEMETRY_BUCKETS ? b : LUALADSPA_TELEMETRY_BUCKETS - 1;
+}
+
+void PublishTelemetry(PluginHandle* H, unsigned long samples, double seconds) {
+	Telemetry* T = H->telemetry.get();
+	if (!T) return;
+	lualadspa_stats* S = T->stats;
+	const uint32_t seq = S->seq; // we are the only writer
+	__atomic_store_n(&S->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+	if (samples) {
+		S->blocks++;
+		S->samples += samples;
+		S->run_time += seconds;
+		S->run_hist[histBucket(seconds)]++;
+	}
+	S->errors = H->errors;
+	S->shutdown = H->shutdown;
+	const auto& A = H->L.allocdata;
+	S->memory = A.allocated;
+	S->memory_limit = A.maxlimit;
+	S->memory_peak = A.peak;
+	S->run_allocations = A.runAllocations;
+	S->run_bytes = A.runBytes;
+	S->gc_time = T->gcTime;
+	__atomic_store_n(&S->seq, seq + 2, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,341 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Background worker thread for heavy non realtime work
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "lualadspa.hpp"
+#include "queue.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <thread>
+
+/*
+ * Worker has it's own lua state, that runs the same plugin chunk, so
+ * job functions are just globals there. Instance posts jobs and gets
+ * results through SPSC queues. Values are serialized, because they
+ * can't be passed between lua states directly.
+ */
+constexpr size_t worker_queue_size = 64;
+constexpr size_t worker_slot_reserve = 256; // bytes
+
+using WorkQueue = SPSCQueue<std::string, worker_queue_size>;
+
+class Worker {
+	public:
+	PlugPropShared P;
+	double samplerate;
+	WorkQueue jobs;    // instance -> worker
+	WorkQueue results; // worker -> instance
+	std::mutex lock;   // for waiting only
+	std::condition_variable cv;
+	std::atomic<bool> stop{false};
+	std::atomic<bool> dead{false};
+	std::thread thread;
+
+	void loop();
+};
+
+/*
+ * Serialization. Format is type byte + data :
+ * n - nil, t/f - boolean, d - number, s - string, v - vector,
+ * b - buffer (copied), a - array of numbers.
+ */
+
+template <typename T>
+static inline void putRaw(std::string& out, const T& v) {
+	out.append(reinterpret_cast<const char*>(&v), sizeof(T));
+}
+
+template <typename T>
+static inline T getRaw(lua_State* L, const std::string& in, size_t& pos) {
+	T v;
+	if (pos + sizeof(T) > in.size()) luaL_error(L, "corrupted worker message");
+	std::memcpy(&v, in.data() + pos, sizeof(T));
+	pos += sizeof(T);
+	return v;
+}
+
+static void serializeValue(lua_State* L, int idx, std::string& out) {
+	switch (lua_type(L, idx)) {
+	case LUA_TNIL: out += 'n'; break;
+	case LUA_TBOOLEAN: out += lua_toboolean(L, idx) ? 't' : 'f'; break;
+	case LUA_TNUMBER:
+		out += 'd';
+		putRaw(out, lua_tonumber(L, idx));
+		break;
+	case LUA_TSTRING: {
+		size_t len;
+		const char* s = lua_tolstring(L, idx, &len);
+		out += 's';
+		putRaw(out, (uint32_t)len);
+		out.append(s, len);
+		break;
+	}
+	case LUA_TVECTOR: {
+		const float* v = lua_tovector(L, idx);
+		out += 'v';
+		out.append(reinterpret_cast<const char*>(v), sizeof(float) * 4);
+		break;
+	}
+	case LUA_TUSERDATA: {
+		LadspaBuffer* B = CheckBuffer(L, idx);
+		out += 'b';
+		putRaw(out, (uint32_t)B->size);
+		if (B->size) out.append(reinterpret_cast<const char*>(B->buffer),
+			B->size * sizeof(sample_type));
+		break;
+	}
+	case LUA_TTABLE: {
+		int n = lua_objlen(L, idx);
+		out += 'a';
+		putRaw(out, (uint32_t)n);
+		for (int i = 1; i <= n; i++) {
+			lua_rawgeti(L, idx, i);
+			if (!lua_isnumber(L, -1))
+				luaL_error(L, "only arrays of numbers can be passed to worker");
+			putRaw(out, lua_tonumber(L, -1));
+			lua_pop(L, 1);
+		}
+		break;
+	}
+	default:
+		luaL_error(L, "%s can't be passed to worker", luaL_typename(L, idx));
+	}
+}
+
+// pushes all values from message (starting at pos), returns count
+static int deserializeValues(lua_State* L, const std::string& in, size_t pos) {
+	int n = 0;
+	while (pos < in.size()) {
+		luaL_checkstack(L, 2, "too many values");
+		char t = in[pos++];
+		switch (t) {
+		case 'n': lua_pushnil(L); break;
+		case 't': lua_pushboolean(L, 1); break;
+		case 'f': lua_pushboolean(L, 0); break;
+		case 'd': lua_pushnumber(L, getRaw<double>(L, in, pos)); break;
+		case 's': {
+			uint32_t len = getRaw<uint32_t>(L, in, pos);
+			if (pos + len > in.size()) luaL_error(L, "corrupted worker message");
+			lua_pushlstring(L, in.data() + pos, len);
+			pos += len;
+			break;
+		}
+		case 'v': {
+			float v[4];
+			for (int k = 0; k < 4; k++) v[k] = getRaw<float>(L, in, pos);
+			lua_pushvector(L, v[0], v[1], v[2], v[3]);
+			break;
+		}
+		case 'b': {
+			uint32_t len = getRaw<uint32_t>(L, in, pos);
+			if (pos + len * sizeof(sample_type) > in.size())
+				luaL_error(L, "corrupted worker message");
+			LadspaBuffer* B = AllocBuffer(L, len);
+			if (len) std::memcpy(B->buffer, in.data() + pos, len * sizeof(sample_type));
+			pos += len * sizeof(sample_type);
+			break;
+		}
+		case 'a': {
+			uint32_t len = getRaw<uint32_t>(L, in, pos);
+			lua_createtable(L, len, 0);
+			for (uint32_t i = 1; i <= len; i++) {
+				lua_pushnumber(L, getRaw<double>(L, in, pos));
+				lua_rawseti(L, -2, i);
+			}
+			break;
+		}
+		default:
+			luaL_error(L, "corrupted worker message");
+		}
+		n++;
+	}
+	return n;
+}
+
+/*
+ * Worker thread
+ */
+
+// runs job in the worker state : fname, args... -> results
+static int doJob(lua_State* L) {
+	const std::string& job = *reinterpret_cast<const std::string*>(
+		lua_tolightuserdata(L, 1));
+	std::string& res = *reinterpret_cast<std::string*>(
+		lua_tolightuserdata(L, 2));
+	lua_settop(L, 0);
+	int n = deserializeValues(L, job, 0);
+	if (n < 1 || !lua_isstring(L, 1)) luaL_error(L, "job name excepted");
+	lua_getfield(L, LUA_GLOBALSINDEX, lua_tostring(L, 1));
+	if (!lua_isfunction(L, -1))
+		luaL_error(L, "no worker function %s", lua_tostring(L, 1));
+	lua_replace(L, 1); // name was copied to the result already
+	lua_call(L, n - 1, LUA_MULTRET);
+	for (int i = 1; i <= lua_gettop(L); i++) serializeValue(L, i, res);
+	return 0;
+}
+
+void Worker::loop() {
+	LuaState L;
+	InitInstanceState(L);
+	SetProperties(L, P.get());
+	lua_pushnumber(L, samplerate);
+	lua_setfield(L, LUA_REGISTRYINDEX, "samplerate");
+	lua_pushboolean(L, 1);
+	lua_setfield(L, LUA_REGISTRYINDEX, "worker");
+
+	if (!L.loadBytecode(*P->bytecode, P->name) || lua_pcall(L, 0, 0, 0) != LUA_OK) {
+		logError("Can't start worker of plugin %s! Error : %s!", P->name,
+			lua_isstring(L, -1) ? lua_tostring(L, -1) : "?");
+		dead = true;
+		return;
+	}
+
+	std::string error;
+	while (!stop) {
+		std::string* job = jobs.front();
+		if (!job) {
+			std::unique_lock<std::mutex> guard(lock);
+			cv.wait_for(guard, std::chrono::milliseconds(20), [this] () {
+				return stop || !jobs.empty();
+			});
+			continue;
+		}
+		// wait for free result slot
+		std::string* res = nullptr;
+		while (!stop && !(res = results.back()))
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		if (!res) break;
+
+		// result is status + job name + values
+		res->clear();
+		res->push_back('o');
+		uint32_t len; // name is always a string
+		std::memcpy(&len, job->data() + 1, sizeof(len));
+		const size_t header = 1 + (1 + sizeof(len) + len);
+		res->append(job->data(), header - 1);
+
+		lua_pushcfunction(L, doJob, "workerjob");
+		lua_pushlightuserdata(L, job);
+		lua_pushlightuserdata(L, res);
+		if (lua_pcall(L, 2, 0, 0) != LUA_OK) {
+			error = lua_isstring(L, -1) ? lua_tostring(L, -1) : "?";
+			lua_pop(L, 1);
+			logError("Error in worker of plugin %s : %s", P->name, error.c_str());
+			res->resize(header);
+			(*res)[0] = 'e';
+			res->push_back('s');
+			len = error.size();
+			putRaw(*res, len);
+			res->append(error);
+		}
+		jobs.pop();
+		results.push();
+	}
+}
+
+void WorkerDeleter::operator()(Worker* W) const {
+	W->stop = true;
+	W->cv.notify_one();
+	if (W->thread.joinable()) W->thread.join();
+	delete W;
+}
+
+WorkerPtr StartWorker(PluginHandle* H) {
+	WorkerPtr W(new Worker);
+	W->P = H->P;
+	W->samplerate = GetSampleRate(H->L);
+	// preallocate slots, so posting small jobs does not allocate
+	auto reserve = [] (std::string& s) {s.reserve(worker_slot_reserve);};
+	W->jobs.forEachSlot(reserve);
+	W->results.forEachSlot(reserve);
+	W->thread = std::thread(&Worker::loop, W.get());
+	return W;
+}
+
+// delivers one result to the instance : onWorkDone(name, results...)
+static int deliver(lua_State* L) {
+	const std::string& msg = *reinterpret_cast<const std::string*>(
+		lua_tolightuserdata(L, 1));
+	const char* hook = msg[0] == 'o' ? "onWorkDone" : "onWorkError";
+	lua_settop(L, 0);
+	if (lua_getfield(L, LUA_GLOBALSINDEX, hook) != LUA_TFUNCTION) return 0;
+	int n = deserializeValues(L, msg, 1);
+	lua_call(L, n, 0);
+	return 0;
+}
+
+void PollWorker(PluginHandle* H) {
+	Worker* W = H->worker.get();
+	lua_State* L = H->L;
+	while (std::string* msg = W->results.front()) {
+		lua_pushcfunction(L, deliver, "deliver");
+		lua_pushlightuserdata(L, msg);
+		if (lua_pcall(L, 1, 0, 0) != LUA_OK) {
+			logError("Error while delivering worker result : %s",
+				lua_tostring(L, -1));
+			lua_pop(L, 1);
+		}
+		W->results.pop();
+	}
+}
+
+/*
+ * Lua API
+ */
+
+// ladspa.post(name, args...) -> true if job was queued
+static int lwork_post(lua_State* L) {
+	if (lua_type(L, 1) != LUA_TSTRING) luaL_typeerror(L, 1, "string");
+	PluginHandle* H = GetHandle(L);
+	if (!H || !H->worker) {
+		luaL_error(L, "no worker here (set info.worker = true)");
+	}
+	Worker* W = H->worker.get();
+	std::string* slot = W->dead ? nullptr : W->jobs.back();
+	if (!slot) {
+		lua_pushboolean(L, 0);
+		return 1;
+	}
+	slot->clear();
+	int n = lua_gettop(L);
+	for (int i = 1; i <= n; i++) serializeValue(L, i, *slot);
+	W->jobs.push();
+	W->cv.notify_one();
+	lua_pushboolean(L, 1);
+	return 1;
+}
+
+// ladspa.isWorker() -> true in the worker state
+static int lwork_isworker(lua_State* L) {
+	lua_getfield(L, LUA_REGISTRYINDEX, "worker");
+	lua_pushboolean(L, lua_toboolean(L, -1));
+	return 1;
+}
+
+static const luaL_Reg worker_funcs[] = {
+	{"post", lwork_post},
+	{"isWorker", lwork_isworker},
+	{nullptr, nullptr}
+};
+
+void OpenLuaWorker(lua_State* L) {
+	luaL_register(L, "ladspa", worker_funcs);
+	lua_pop(L, 1);
+}
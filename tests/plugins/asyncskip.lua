@@ -0,0 +1,34 @@
+-- Async plugin, that is late once (see tests/tests.cpp)
+
+info = {
+	name = "Async Skip Test",
+	label = "testasyncskip",
+	async = 256,
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+ports = {
+	{
+		type = "ia",
+		name = "Input"
+	}, {
+		type = "oa",
+		name = "Output"
+	}, {
+		type = "oc",
+		name = "latency"
+	}
+}
+
+local late = false
+
+function run(sz)
+	local input, output = buffers[1], buffers[2]
+	if not late and input[1] >= 10 then
+		late = true
+		local x = 0
+		for i = 1, 3000000 do x = x + i end
+	end
+	for i = 1, sz do output[i] = input[i] end
+end
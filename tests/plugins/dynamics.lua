@@ -0,0 +1,54 @@
+-- Test of native dynamics objects (see tests/tests.cpp)
+
+info = {
+	name = "Dynamics Test",
+	label = "testdynamics",
+	realtime = true,
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+ports = {
+	{
+		type = "oc",
+		name = "result"
+	}
+}
+
+local function check(ok, what)
+	if not ok then error(what, 2) end
+end
+
+-- envelope right at the threshold, with hard knee (default)
+local function gainAtThreshold()
+	local gain = ladspa.newGainComputer(0, 4)
+	local env, out = ladspa.newBuffer(4), ladspa.newBuffer(4)
+	for i = 1, 4 do env[i] = 1 end -- 0 dB
+	gain:process(env, out)
+	for i = 1, 4 do
+		check(math.abs(out[i] - 1) < 1e-6, "gain at threshold is " .. out[i])
+	end
+end
+
+-- decaying peak fills the whole lookahead window
+local function limiterWindow()
+	local lim = ladspa.newLimiter(1, 1, 0) -- instant release
+	local delay = lim:latency()
+	local signal = {}
+	for i = 1, 100 do table.insert(signal, 0) end
+	for i = 0, delay + 20 do table.insert(signal, 4 - 3 * i / (delay + 20)) end
+	for i = 1, 2 * delay do table.insert(signal, 0.5) end
+	local input, output = ladspa.newBuffer(1), ladspa.newBuffer(1)
+	for i, x in signal do
+		input[1] = x
+		local g = lim:process(input, output, 1)
+		local late = signal[i - delay] or 0
+		check(math.abs(late) * g <= 1.05, "limiter missed peak at " .. i)
+	end
+end
+
+function run(sz)
+	gainAtThreshold()
+	limiterWindow()
+	buffers[1][1] = 1
+end
@@ -0,0 +1,74 @@
+-- State saved by one instance, and loaded into another (see tests/tests.cpp)
+
+info = {
+	name = "State Test",
+	label = "teststate",
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+ports = {
+	{
+		type = "oc",
+		name = "result"
+	}
+}
+
+local function check(ok, what)
+	if not ok then error(what, 2) end
+end
+
+local numbers = {
+	0, 1, -1, 127, 128, -128, 2^31, -2^31, 2^53 - 1, -(2^53 - 1),
+	2^53, -2^53, 2^63, 0.5, -0.1, 1e300, 1e-300, math.huge, -math.huge
+}
+
+function saveState()
+	local shared = {value = "shared"}
+	local cycle = {}
+	cycle.self = cycle
+	local buf = ladspa.newBuffer(5)
+	for i = 1, 5 do buf[i] = i * 0.25 - 1 end
+	return {
+		nested = {a = {b = {c = "deep"}}, shared = shared},
+		other = {shared},
+		cycle = cycle,
+		buffer = buf,
+		empty = ladspa.newBuffer(0),
+		numbers = numbers,
+		nan = 0 / 0,
+		negzero = -0.0,
+		keys = {"first", "second", ["1"] = "string 1", ["2"] = "string 2",
+			["nan"] = "string nan", ["1.5"] = "string 1.5", [1.5] = "number 1.5",
+			[-1] = "number -1", [0] = "number 0", [true] = "boolean"},
+	}
+end
+
+local loaded = false
+
+function loadState(s)
+	check(s.nested.a.b.c == "deep", "nested table")
+	check(s.nested.shared == s.other[1], "shared table")
+	check(s.nested.shared.value == "shared", "shared table value")
+	check(s.cycle.self == s.cycle, "cycle")
+	check(#s.buffer == 5 and #s.empty == 0, "buffer size")
+	for i = 1, 5 do check(s.buffer[i] == i * 0.25 - 1, "buffer data") end
+	check(#s.numbers == #numbers, "numbers count")
+	for i, x in numbers do
+		check(s.numbers[i] == x, "number " .. tostring(x) .. " is " ..
+			tostring(s.numbers[i]))
+	end
+	check(s.nan ~= s.nan, "nan")
+	check(s.negzero == 0 and 1 / s.negzero < 0, "negative zero")
+	local k = s.keys
+	check(k[1] == "first" and k[2] == "second", "array part")
+	check(k["1"] == "string 1" and k["2"] == "string 2", "numeric string keys")
+	check(k["nan"] == "string nan" and k["1.5"] == "string 1.5", "string keys")
+	check(k[1.5] == "number 1.5" and k[-1] == "number -1" and
+		k[0] == "number 0" and k[true] == "boolean", "other keys")
+	loaded = true
+end
+
+function run(sz)
+	buffers[1][1] = loaded and 1 or 0
+end
@@ -0,0 +1,48 @@
+-- Buffer views and resizing of their parents (see tests/tests.cpp)
+
+info = {
+	name = "Views Test",
+	label = "testviews",
+	luaLadspaVersionMinor = 3,
+	luaLadspaVersionMajor = 0
+}
+
+ports = {
+	{
+		type = "oc",
+		name = "result"
+	}
+}
+
+local function check(ok, what)
+	if not ok then error(what, 2) end
+end
+
+-- view must not point to the freed storage of resized parent
+local function resizeWithView()
+	local a = ladspa.newBuffer(64)
+	local v = a:view(0, 64)
+	check(not pcall(ladspa.resizeBuffer, a, 65536), "buffer with view is resized")
+	check(#a == 64, "buffer size is changed")
+	local b = ladspa.newBuffer(64)
+	for i = 1, 64 do b[i] = 7 end
+	v[1] = 3
+	check(a[1] == 3 and v[1] == 3, "view doesn't alias parent")
+	-- retargeted view doesn't keep old parent
+	b:view(0, 64, v)
+	check(ladspa.resizeBuffer(a, 128) and #a == 128, "buffer without views isn't resized")
+	check(not pcall(ladspa.resizeBuffer, b, 128), "new parent is resized")
+end
+
+-- dead views (not collected yet) don't prevent resizing
+local function resizeAfterView()
+	local a = ladspa.newBuffer(64)
+	for i = 1, 8 do a:view(i, 8) end
+	check(ladspa.resizeBuffer(a, 256) and #a == 256, "buffer with dead views isn't resized")
+end
+
+function run(sz)
+	resizeWithView()
+	resizeAfterView()
+	buffers[1][1] = 1
+end
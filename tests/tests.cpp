@@ -0,0 +1,237 @@
+/*
+ * LuaLadspa - write your own LADSPA plugins on lua :)
+ * Regression tests : loads liblualadspa with test plugins only (in the
+ * temporary $HOME), and runs them as a host does.
+ * Copyright (C) 2023 UtoECat
+
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "../src/ladspa.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <dlfcn.h>
+#include <unistd.h>
+
+namespace fsys = std::filesystem;
+
+typedef FILE* (*logSetter)(FILE* f);
+typedef void* (*stateSaver)(LADSPA_Handle instance, size_t* size);
+typedef void (*stateFreer)(void* state);
+typedef int (*stateLoader)(LADSPA_Handle instance, const void* data,
+	size_t size);
+
+static stateSaver saveState;
+static stateFreer freeState;
+static stateLoader loadState;
+
+constexpr unsigned long test_rate = 48000;
+
+static const LADSPA_Descriptor* findPlugin(LADSPA_Descriptor_Function get,
+		const char* label) {
+	const LADSPA_Descriptor* D;
+	for (unsigned long i = 0; (D = get(i)) != nullptr; i++)
+		if (D->ImplementationData && std::strcmp(D->Label, label) == 0) return D;
+	return nullptr;
+}
+
+static long findPort(const LADSPA_Descriptor* D, const char* name) {
+	for (unsigned long i = 0; i < D->PortCount; i++)
+		if (std::strcmp(D->PortNames[i], name) == 0) return i;
+	return -1;
+}
+
+/*
+ * Plugin checks itself in run(), and sets "result" control output to 1.
+ * Errors are logged by the library.
+ */
+static std::string selfCheck(const LADSPA_Descriptor* D) {
+	const long result = findPort(D, "result");
+	if (result < 0) return "no result port";
+	auto inst = D->instantiate(D, test_rate);
+	if (!inst) return "can't instantiate";
+	std::vector<std::vector<LADSPA_Data>> bufs(D->PortCount,
+		std::vector<LADSPA_Data>(256, 0.0f));
+	for (unsigned long i = 0; i < D->PortCount; i++)
+		D->connect_port(inst, i, bufs[i].data());
+	bufs[result][0] = -1.0f;
+	D->activate(inst);
+	D->run(inst, 256);
+	D->deactivate(inst);
+	D->cleanup(inst);
+	return bufs[result][0] == 1.0f ? "" : "plugin check failed";
+}
+
+/*
+ * Async plugin copies input to output, and is late once. Input is number
+ * of the async block, so every sample host gets is either output of the
+ * right block, or silence (late or skipped block), never an older one.
+ */
+static std::string asyncSkip(const LADSPA_Descriptor* D) {
+	const long in = findPort(D, "Input"), out = findPort(D, "Output");
+	const long latency = findPort(D, "latency");
+	if (in < 0 || out < 0 || latency < 0) return "no ports";
+	auto inst = D->instantiate(D, test_rate);
+	if (!inst) return "can't instantiate";
+	constexpr unsigned long block = 64, async = 256; // info.async
+	std::vector<std::vector<LADSPA_Data>> bufs(D->PortCount,
+		std::vector<LADSPA_Data>(block, 0.0f));
+	for (unsigned long i = 0; i < D->PortCount; i++)
+		D->connect_port(inst, i, bufs[i].data());
+	D->activate(inst);
+
+	std::string error;
+	size_t silent = 0, right = 0;
+	for (unsigned long b = 0; b < 400 && error.empty(); b++) {
+		for (unsigned long i = 0; i < block; i++)
+			bufs[in][i] = (b * block + i) / async + 1;
+		D->run(inst, block);
+		const long delay = bufs[latency][0];
+		for (unsigned long i = 0; i < block; i++) {
+			const long pos = b * block + i - delay;
+			const float v = bufs[out][i];
+			if (v == 0.0f) silent++;
+			else if (pos >= 0 && v == (float)(pos / async + 1)) right++;
+			else error = "output " + std::to_string(v) + " at " +
+				std::to_string(b * block + i);
+		}
+		usleep(1000); // ~4 ms per async block, plugin is much faster
+	}
+	D->deactivate(inst);
+	D->cleanup(inst);
+	if (error.empty() && (silent < 4 * async || right < block * 200))
+		error = "plugin was never late, or never caught up (" +
+			std::to_string(silent) + " silent samples)";
+	return error;
+}
+
+/*
+ * State of one instance is loaded into another one, plugin checks it in
+ * loadState(), and sets "result" to 1 in run() if it was loaded. Broken
+ * (truncated) state must not be loaded at all.
+ */
+static float runOnce(const LADSPA_Descriptor* D, LADSPA_Handle inst) {
+	LADSPA_Data result = -1.0f;
+	D->connect_port(inst, findPort(D, "result"), &result);
+	D->activate(inst);
+	D->run(inst, 1);
+	D->deactivate(inst);
+	return result;
+}
+
+static std::string stateRoundTrip(const LADSPA_Descriptor* D) {
+	if (findPort(D, "result") < 0) return "no result port";
+	auto a = D->instantiate(D, test_rate);
+	auto b = D->instantiate(D, test_rate);
+	auto c = D->instantiate(D, test_rate);
+	if (!a || !b || !c) return "can't instantiate";
+	std::string error;
+	size_t size = 0;
+	void* state = saveState(a, &size);
+	if (!state) error = "can't save state";
+	else if (!loadState(b, state, size)) error = "can't load state";
+	else if (runOnce(D, b) != 1.0f) error = "state is not loaded";
+	else if (loadState(c, state, size - 1)) error = "truncated state is loaded";
+	else if (runOnce(D, c) != 0.0f) error = "truncated state changed plugin";
+	if (state) freeState(state);
+	D->cleanup(a);
+	D->cleanup(b);
+	D->cleanup(c);
+	return error;
+}
+
+struct Test {
+	const char* label;
+	std::string (*check)(const LADSPA_Descriptor*);
+};
+
+static const Test tests[] = {
+	{"testdynamics", selfCheck},
+	{"testasyncskip", asyncSkip},
+	{"teststate", stateRoundTrip},
+	{"testviews", selfCheck},
+};
+
+// temporary $HOME with test plugins only (and clean cache)
+static fsys::path makeHome(const fsys::path& plugins) {
+	char tmpl[] = "/tmp/lualadspa-tests.XXXXXX";
+	if (!mkdtemp(tmpl)) return {};
+	fsys::path home(tmpl);
+	fsys::create_directories(home / ".lualadspa");
+	for (auto& e : fsys::directory_iterator(plugins))
+		if (e.path().extension() == ".lua")
+			fsys::copy_file(e.path(), home / ".lualadspa" / e.path().filename());
+	setenv("HOME", home.c_str(), 1);
+	setenv("XDG_CACHE_HOME", (home / "cache").c_str(), 1);
+	return home;
+}
+
+int main(int argc, char** argv) {
+	const fsys::path plugins = argc > 1 ? argv[1] : "./tests/plugins";
+	const fsys::path lib = fsys::absolute(argc > 2 ? argv[2] : "./liblualadspa.so");
+	std::error_code ec;
+	const fsys::path home = makeHome(plugins);
+	if (home.empty()) {
+		fprintf(stderr, "Can't make temporary home!\n");
+		return 1;
+	}
+	fsys::current_path(home, ec); // library opens lladspa.log here
+	auto handle = dlopen(lib.c_str(), RTLD_NOW);
+	if (!handle) {
+		fprintf(stderr, "Can't open %s : %s!\n", lib.c_str(), dlerror());
+		return 1;
+	}
+	auto get = reinterpret_cast<LADSPA_Descriptor_Function>(
+		dlsym(handle, "ladspa_descriptor"));
+	auto setLog = reinterpret_cast<logSetter>(dlsym(handle, "setlogdesc"));
+	saveState = reinterpret_cast<stateSaver>(
+		dlsym(handle, "lualadspa_save_state"));
+	freeState = reinterpret_cast<stateFreer>(
+		dlsym(handle, "lualadspa_free_state"));
+	loadState = reinterpret_cast<stateLoader>(
+		dlsym(handle, "lualadspa_load_state"));
+	if (!get || !setLog || !saveState || !freeState || !loadState) {
+		fprintf(stderr, "Invalid %s!\n", lib.c_str());
+		return 1;
+	}
+	// library log is shown only if something failed
+	FILE* log = std::tmpfile();
+	FILE* old = setLog(log ? log : stderr);
+	if (old != stderr && old != stdout) fclose(old);
+
+	int failed = 0;
+	for (const Test& T : tests) {
+		const LADSPA_Descriptor* D = findPlugin(get, T.label);
+		std::string error = D ? T.check(D) : "plugin is not loaded";
+		printf("%-24s %s%s\n", T.label, error.empty() ? "ok" : "FAIL : ",
+			error.c_str());
+		if (!error.empty()) failed++;
+	}
+	dlclose(handle);
+	fsys::remove_all(home, ec);
+	if (failed && log) {
+		std::rewind(log);
+		char buf[4096];
+		size_t n;
+		while ((n = std::fread(buf, 1, sizeof(buf), log)) > 0)
+			std::fwrite(buf, 1, n, stderr);
+	}
+	printf("%i of %zu tests failed\n", failed, sizeof(tests) / sizeof(tests[0]));
+	return failed ? 1 : 0;
+}